@@ -0,0 +1,382 @@
+/*
+    10) FIXED-POINT MONEY TYPE (64-bit, 1 unit = 1 cent)
+
+    Explanation:
+    - Banking spec: double balance, vector<double> transactions
+      -> 0.10 has no exact binary form: ten million deposits of 0.10 do NOT
+         add up to 1,000,000.00, and two batch runs can disagree in the last cent
+    - Money: one int64 holding cents
+      -> +, -, compare are plain integer instructions (exact, fast)
+      -> sizeof(Money) == 8: an array of Money IS an array of int64,
+         so settlement loops vectorize like integer loops
+    - Three kinds of arithmetic:
+      -> operators (a + b):        fastest, caller guarantees no overflow
+      -> checked (checkedAdd):     returns false on overflow, result untouched
+      -> saturating (saturatingAdd): clamps to the min / max, branch-free
+    - Array kernels (AVX2, 4 accounts per instruction, scalar fallback):
+          applyDeltas(balances, deltas, n)  saturating balances[i] += deltas[i]
+          exactTotal(values, n)             128-bit exact sum + overflow flag
+          countBelow(values, n, floor)      how many accounts under a limit
+    - Text in / out without double: parse("19.99"), toString() -> "19.99"
+    - Used by oop/4_static_members.cpp and oop/7_encapsulation.cpp (compact,
+      checked-only copies); banking programs 1-9 hold their own int64 cents
+
+    Compile with AVX2 enabled for the vector kernels:
+        g++ -O2 -mavx2 10_fixed_point_money.cpp
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <cctype>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ===== MONEY =====
+class Money {
+private:
+    int64_t cents;
+
+public:
+    static const int64_t MAX_CENTS = INT64_MAX;
+    static const int64_t MIN_CENTS = INT64_MIN;
+
+    Money() : cents(0) {}
+
+    // ----- Factories -----
+    static Money fromCents(int64_t c) {
+        Money m;
+        m.cents = c;
+        return m;
+    }
+
+    static Money dollars(int64_t d) {
+        return fromCents(d * 100);
+    }
+
+    // Nearest cent (for data that already arrives as double)
+    static Money fromDouble(double amount) {
+        return fromCents((int64_t)llround(amount * 100.0));
+    }
+
+    // "123", "-4.5", "0.07" -> exact cents; false on bad text or more than 2 decimals
+    static bool parse(const string& text, Money& out) {
+        size_t i = 0;
+        bool negative = false;
+        if (i < text.size() && (text[i] == '-' || text[i] == '+')) negative = text[i++] == '-';
+        int64_t whole = 0, fraction = 0;
+        int wholeDigits = 0, fractionDigits = 0;
+        while (i < text.size() && isdigit((unsigned char)text[i])) {
+            if (__builtin_mul_overflow(whole, 10, &whole) || __builtin_add_overflow(whole, text[i] - '0', &whole)) return false;
+            i++;
+            wholeDigits++;
+        }
+        if (i < text.size() && text[i] == '.') {
+            i++;
+            while (i < text.size() && isdigit((unsigned char)text[i]) && fractionDigits < 2) {
+                fraction = fraction * 10 + (text[i++] - '0');
+                fractionDigits++;
+            }
+            if (fractionDigits == 1) fraction *= 10;
+        }
+        if (i != text.size() || wholeDigits + fractionDigits == 0) return false;
+        int64_t c;
+        if (__builtin_mul_overflow(whole, 100, &c) || __builtin_add_overflow(c, fraction, &c)) return false;
+        out = fromCents(negative ? -c : c);
+        return true;
+    }
+
+    // ----- Access -----
+    int64_t toCents() const { return cents; }
+    double toDouble() const { return cents / 100.0; }
+
+    string toString() const {
+        uint64_t magnitude = cents < 0 ? 0 - (uint64_t)cents : (uint64_t)cents;     // Safe for MIN_CENTS
+        string frac = to_string(magnitude % 100);
+        return (cents < 0 ? "-" : "") + to_string(magnitude / 100) + "." + (frac.size() == 1 ? "0" : "") + frac;
+    }
+
+    // ----- Plain operators (no overflow check) -----
+    Money operator+(Money o) const { return fromCents(cents + o.cents); }
+    Money operator-(Money o) const { return fromCents(cents - o.cents); }
+    Money operator-() const { return fromCents(-cents); }
+    Money& operator+=(Money o) { cents += o.cents; return *this; }
+    Money& operator-=(Money o) { cents -= o.cents; return *this; }
+    bool operator==(Money o) const { return cents == o.cents; }
+    bool operator!=(Money o) const { return cents != o.cents; }
+    bool operator<(Money o) const { return cents < o.cents; }
+    bool operator<=(Money o) const { return cents <= o.cents; }
+    bool operator>(Money o) const { return cents > o.cents; }
+    bool operator>=(Money o) const { return cents >= o.cents; }
+
+    // ----- Checked (false on overflow, 'out' untouched) -----
+    static bool checkedAdd(Money a, Money b, Money& out) {
+        int64_t c;
+        if (__builtin_add_overflow(a.cents, b.cents, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    static bool checkedSub(Money a, Money b, Money& out) {
+        int64_t c;
+        if (__builtin_sub_overflow(a.cents, b.cents, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    static bool checkedMul(Money a, int64_t factor, Money& out) {
+        int64_t c;
+        if (__builtin_mul_overflow(a.cents, factor, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    // a * numerator / denominator, rounded half away from zero (e.g. rates)
+    static bool checkedScale(Money a, int64_t numerator, int64_t denominator, Money& out) {
+        if (denominator == 0) return false;
+        __int128 p = (__int128)a.cents * numerator;
+        __int128 d = denominator;
+        bool negative = (p < 0) != (d < 0);
+        if (p < 0) p = -p;
+        if (d < 0) d = -d;
+        __int128 q = (p + d / 2) / d;                   // Magnitude, rounded half up
+        if (negative) q = -q;
+        if (q > MAX_CENTS || q < MIN_CENTS) return false;
+        out.cents = (int64_t)q;
+        return true;
+    }
+
+    // ----- Saturating (branch-free: clamps instead of wrapping) -----
+    static Money saturatingAdd(Money a, Money b) {
+        uint64_t s = (uint64_t)a.cents + (uint64_t)b.cents;              // Wraps, no UB
+        int64_t sum = (int64_t)s;
+        int64_t overflow = ((a.cents ^ sum) & (b.cents ^ sum)) >> 63;       // -1 if sign flipped wrongly
+        int64_t limit = (a.cents >> 63) ^ MAX_CENTS;                        // a < 0 -> MIN, else MAX
+        return fromCents((sum & ~overflow) | (limit & overflow));
+    }
+
+    static Money saturatingSub(Money a, Money b) {
+        uint64_t s = (uint64_t)a.cents - (uint64_t)b.cents;
+        int64_t diff = (int64_t)s;
+        int64_t overflow = ((a.cents ^ b.cents) & (a.cents ^ diff)) >> 63;
+        int64_t limit = (a.cents >> 63) ^ MAX_CENTS;
+        return fromCents((diff & ~overflow) | (limit & overflow));
+    }
+};
+
+static_assert(sizeof(Money) == sizeof(int64_t), "Money must stay one int64 so arrays vectorize");
+
+// Static constant definitions (ODR-used by the saturating helpers)
+const int64_t Money::MAX_CENTS;
+const int64_t Money::MIN_CENTS;
+
+ostream& operator<<(ostream& out, Money m) {
+    return out << m.toString();
+}
+
+// ===== ARRAY KERNELS =====
+// Money is one int64, so Money arrays are read / written as int64 lanes
+
+// balances[i] = saturatingAdd(balances[i], deltas[i])
+void applyDeltas(Money* balances, const Money* deltas, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i maxCents = _mm256_set1_epi64x(Money::MAX_CENTS);
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(balances + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(deltas + i));
+        __m256i s = _mm256_add_epi64(a, b);
+        __m256i overflow = _mm256_cmpgt_epi64(zero, _mm256_and_si256(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s)));
+        __m256i limit = _mm256_xor_si256(_mm256_cmpgt_epi64(zero, a), maxCents);
+        _mm256_storeu_si256((__m256i*)(balances + i), _mm256_blendv_epi8(s, limit, overflow));
+    }
+#endif
+    for (; i < n; i++) balances[i] = Money::saturatingAdd(balances[i], deltas[i]);
+}
+
+// Exact sum of any n < 2^31 values: high and low 32-bit halves summed separately
+// (neither can overflow int64), combined in 128 bits.
+// 'fits' = false if the true total does not fit in a Money.
+Money exactTotal(const Money* values, size_t n, bool& fits) {
+    int64_t highSum = 0, lowSum = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFFLL);
+    __m256i high = _mm256_setzero_si256(), low = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+        // Arithmetic v >> 32: high dword into the low half, its sign into the high half
+        high = _mm256_add_epi64(high, _mm256_blend_epi32(_mm256_srli_epi64(v, 32), _mm256_srai_epi32(v, 31), 0xAA));
+        low = _mm256_add_epi64(low, _mm256_and_si256(v, lowMask));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, high);
+    highSum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256((__m256i*)lanes, low);
+    lowSum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; i++) {
+        int64_t c = values[i].toCents();
+        highSum += c >> 32;
+        lowSum += c & 0xFFFFFFFFLL;
+    }
+    __int128 total = (__int128)highSum * 4294967296LL + lowSum;
+    fits = total >= Money::MIN_CENTS && total <= Money::MAX_CENTS;
+    return Money::fromCents(fits ? (int64_t)total : 0);
+}
+
+size_t countBelow(const Money* values, size_t n, Money floor) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i f = _mm256_set1_epi64x(floor.toCents());
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+        count += (size_t)__builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(f, v))));
+    }
+#endif
+    for (; i < n; i++) count += values[i] < floor;
+    return count;
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== DRIFT: 10,000,000 DEPOSITS OF 0.10 =====" << endl;
+    {
+        double d = 0;
+        Money m;
+        Money dime;
+        Money::parse("0.10", dime);
+        for (int i = 0; i < 10000000; i++) {
+            d += 0.10;
+            m += dime;
+        }
+        cout.precision(17);
+        cout << "double: " << d << endl;
+        cout.precision(6);
+        cout << "Money : " << m << (m == Money::dollars(1000000) ? " (exactly 1000000.00)" : " (WRONG)") << endl;
+    }
+
+    cout << "\n===== PARSE / PRINT =====" << endl;
+    {
+        const char* inputs[] = {"19.99", "-4.5", "0.07", "1000", "12.345", "abc", "."};
+        for (const char* text : inputs) {
+            Money m;
+            if (Money::parse(text, m)) cout << "  \"" << text << "\" -> " << m << " (" << m.toCents() << " cents)" << endl;
+            else cout << "  \"" << text << "\" -> Error: not a valid amount" << endl;
+        }
+    }
+
+    cout << "\n===== CHECKED AND SATURATING =====" << endl;
+    {
+        Money big = Money::fromCents(Money::MAX_CENTS - 100);
+        Money out;
+        cout << "checkedAdd(max - 1.00, 5.00): " << (Money::checkedAdd(big, Money::dollars(5), out) ? "OK" : "Error: overflow") << endl;
+        cout << "saturatingAdd(max - 1.00, 5.00) = max: "
+             << (Money::saturatingAdd(big, Money::dollars(5)).toCents() == Money::MAX_CENTS ? "YES" : "NO") << endl;
+        cout << "saturatingSub(min + 1.00, 5.00) = min: "
+             << (Money::saturatingSub(Money::fromCents(Money::MIN_CENTS + 100), Money::dollars(5)).toCents() == Money::MIN_CENTS ? "YES" : "NO")
+             << endl;
+        Money interest;
+        Money::checkedScale(Money::fromCents(123456), 4, 100, interest);          // 4% of 1234.56
+        cout << "4% of 1234.56 = " << interest << " (49.3824 rounded)" << endl;
+        Money::checkedScale(Money::fromCents(-125), 1, 10, interest);             // -0.125 -> -0.13
+        cout << "10% of -1.25 = " << interest << " (half away from zero)" << endl;
+    }
+
+    cout << "\n===== SETTLEMENT KERNELS: 16M ACCOUNTS =====" << endl;
+    {
+        const size_t N = 16u << 20;
+        vector<Money> balances(N), deltas(N);
+        vector<double> balancesD(N), deltasD(N);
+        unsigned seed = 5;
+        for (size_t i = 0; i < N; i++) {
+            seed = seed * 1103515245u + 12345u;
+            balances[i] = Money::fromCents((int64_t)(seed >> 4) % 10000000);
+            seed = seed * 1103515245u + 12345u;
+            deltas[i] = Money::fromCents((int64_t)(seed >> 12) % 200000 - 100000);
+            balancesD[i] = balances[i].toDouble();
+            deltasD[i] = deltas[i].toDouble();
+        }
+        balances[7] = Money::fromCents(Money::MAX_CENTS - 1);     // One account would overflow
+        deltas[7] = Money::dollars(10);
+
+        vector<Money> reference = balances;
+        for (size_t i = 0; i < N; i++) reference[i] = Money::saturatingAdd(reference[i], deltas[i]);
+
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < N; i++) balancesD[i] += deltasD[i];
+        double doubleMs = millisecondsSince(start);
+
+        start = chrono::steady_clock::now();
+        applyDeltas(balances.data(), deltas.data(), N);
+        double moneyMs = millisecondsSince(start);
+
+        cout << "double +=                  : " << doubleMs << " ms" << endl;
+        cout << "Money applyDeltas (sat.)   : " << moneyMs << " ms, same as scalar: "
+             << (balances == reference ? "YES" : "NO") << ", overflowing account clamped: "
+             << (balances[7].toCents() == Money::MAX_CENTS ? "YES" : "NO") << endl;
+
+        balances[7] = Money();
+        bool fits;
+        start = chrono::steady_clock::now();
+        Money total = exactTotal(balances.data(), N, fits);
+        double totalMs = millisecondsSince(start);
+        __int128 check = 0;
+        for (size_t i = 0; i < N; i++) check += balances[i].toCents();
+        double sumD = 0;
+        for (size_t i = 0; i < N; i++) sumD += balances[i].toDouble();
+        cout << "exactTotal                 : " << total << " in " << totalMs << " ms, matches 128-bit sum: "
+             << (fits && check == total.toCents() ? "YES" : "NO") << endl;
+        cout.precision(17);
+        cout << "double total               : " << sumD << endl;
+        cout.precision(6);
+        cout << "Accounts below 100.00      : " << countBelow(balances.data(), N, Money::dollars(100)) << endl;
+
+        vector<Money> huge(4, Money::fromCents(Money::MAX_CENTS / 2));
+        exactTotal(huge.data(), huge.size(), fits);
+        cout << "Total of 4 x (max / 2) fits in Money: " << (fits ? "YES (wrong)" : "NO (reported, not wrapped)") << endl;
+    }
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Fixed Point
+       - Store integer cents, print with a decimal point
+       - Every + and - is exact: totals never drift
+
+    2. Same Size as int64
+       - static_assert(sizeof(Money) == 8)
+       - Arrays of Money vectorize like arrays of integers
+
+    3. Checked Arithmetic
+       - __builtin_add_overflow / mul_overflow: CPU overflow flag, no guesswork
+       - Returns false and leaves the result untouched
+
+    4. Branch-Free Saturation
+       - Overflow only if both inputs have the same sign and the sum's sign differs:
+         ((a ^ s) & (b ^ s)) < 0
+       - Clamp value from a's sign: (a >> 63) ^ MAX -> MAX or MIN
+       - Select with masks instead of if -> same code in the AVX2 kernel
+
+    5. Exact Totals
+       - Sum the high and low 32-bit halves separately (no lane can overflow)
+       - Combine in 128 bits, then check that the total fits
+
+    6. Rounding Rules in One Place
+       - checkedScale(a, num, den): rates and percentages, half away from zero
+       - fromDouble only at the edges (old data), never inside loops
+*/
@@ -0,0 +1,377 @@
+/*
+    1) CONCURRENT LEDGER (Atomic Transfers Between Any Two Accounts)
+
+    Explanation:
+    - BankAccount::transfer (7_encapsulation.cpp) does
+          balance -= amount;  recipient.balance += amount;
+      with no synchronization: two threads can read the same old balance,
+      both write, and money is created or destroyed (a data race)
+    - One global mutex fixes it but lets only ONE transfer run at a time
+    - Fine-grained locking: every account has its own lock
+      -> a transfer locks ONLY its two accounts
+      -> transfers between different accounts run in parallel
+    - Deadlock: T1 locks A then waits for B, T2 locks B then waits for A
+      -> fix: ALWAYS lock the account with the smaller index first
+         (a global lock order means no cycle of waiting threads can form)
+    - Each account's lock + balance sit on their own 64-byte cache line,
+      so threads working on neighbouring accounts do not slow each other down
+    - Money is stored in integer cents: conservation can be checked EXACTLY
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// ===== PERMISSION FLAGS (banking spec) =====
+const unsigned CAN_WITHDRAW = 1;
+const unsigned CAN_DEPOSIT = 2;
+const unsigned CAN_TRANSFER = 4;
+const unsigned VIP_ACCOUNT = 8;
+
+// ===== ACCOUNT HIERARCHY =====
+class Account {
+protected:
+    int accountId;
+    string name;
+    unsigned int permissions;
+
+    // +deposit / -withdrawal in cents, in chunks of HISTORY_CHUNK entries:
+    // recording under the lock never copies old entries (one allocation per chunk)
+    static const size_t HISTORY_CHUNK = 256;
+    vector<vector<long long>> history;
+
+public:
+    // Hot part on its own cache line: lock + balance
+    struct alignas(64) Guarded {
+        mutex lock;
+        long long balanceCents;
+    } guarded;
+
+    Account(int id, string n, long long cents, unsigned perms)
+        : accountId(id), name(n), permissions(perms) {
+        guarded.balanceCents = cents;
+    }
+
+    virtual ~Account() {}
+
+    // Polymorphic rule: may the balance go down by 'cents'? (lock held)
+    virtual bool canDebit(long long cents) const = 0;
+    virtual string type() const = 0;
+
+    bool hasPermission(unsigned flag) const {
+        return (permissions & flag) != 0;
+    }
+
+    // Caller holds guarded.lock
+    void record(long long cents) {
+        if (history.empty() || history.back().size() == HISTORY_CHUNK) {
+            history.push_back(vector<long long>());
+            history.back().reserve(HISTORY_CHUNK);
+        }
+        history.back().push_back(cents);
+    }
+
+    int getId() const { return accountId; }
+    string getName() const { return name; }
+    size_t historySize() const {
+        return history.empty() ? 0 : (history.size() - 1) * HISTORY_CHUNK + history.back().size();
+    }
+};
+
+class SavingsAccount : public Account {
+public:
+    SavingsAccount(int id, string n, long long cents, unsigned perms)
+        : Account(id, n, cents, perms) {}
+
+    bool canDebit(long long cents) const override {
+        return guarded.balanceCents >= cents;          // Never below zero
+    }
+
+    string type() const override { return "Savings"; }
+};
+
+class CurrentAccount : public Account {
+private:
+    long long overdraftCents;
+
+public:
+    CurrentAccount(int id, string n, long long cents, unsigned perms, long long overdraft)
+        : Account(id, n, cents, perms), overdraftCents(overdraft) {}
+
+    bool canDebit(long long cents) const override {
+        return guarded.balanceCents - cents >= -overdraftCents;
+    }
+
+    string type() const override { return "Current"; }
+};
+
+// ===== LEDGER =====
+class Ledger {
+private:
+    vector<Account*> accounts;            // Index = position in the ledger
+    atomic<long long> permissionDenied;   // Transfers refused by the permission bits
+    atomic<long long> insufficientFunds;  // Transfers refused by canDebit()
+    mutex globalLock;                     // Only used by the baseline
+
+public:
+    Ledger() : permissionDenied(0), insufficientFunds(0) {}
+
+    ~Ledger() {
+        for (size_t i = 0; i < accounts.size(); i++) delete accounts[i];
+    }
+
+    Ledger(const Ledger&) = delete;
+    Ledger& operator=(const Ledger&) = delete;
+
+    // Accounts are added before the worker threads start
+    size_t addAccount(Account* acc) {
+        accounts.push_back(acc);
+        return accounts.size() - 1;
+    }
+
+    bool deposit(size_t index, long long cents) {
+        Account* acc = accounts[index];
+        if (cents <= 0 || !acc->hasPermission(CAN_DEPOSIT)) return false;
+        lock_guard<mutex> lock(acc->guarded.lock);
+        acc->guarded.balanceCents += cents;
+        acc->record(cents);
+        return true;
+    }
+
+    bool withdraw(size_t index, long long cents) {
+        Account* acc = accounts[index];
+        if (cents <= 0 || !acc->hasPermission(CAN_WITHDRAW)) return false;
+        lock_guard<mutex> lock(acc->guarded.lock);
+        if (!acc->canDebit(cents)) return false;
+        acc->guarded.balanceCents -= cents;
+        acc->record(-cents);
+        return true;
+    }
+
+    // Atomic transfer: both balances change, or neither does
+    bool transfer(size_t from, size_t to, long long cents) {
+        if (from == to || cents <= 0) return false;
+        Account* src = accounts[from];
+        Account* dst = accounts[to];
+        if (!src->hasPermission(CAN_TRANSFER) || !dst->hasPermission(CAN_DEPOSIT)) {
+            permissionDenied++;
+            return false;
+        }
+
+        // Deadlock-free: lower index first, no matter which side it is
+        Account* first = from < to ? src : dst;
+        Account* second = from < to ? dst : src;
+        lock_guard<mutex> lockFirst(first->guarded.lock);
+        lock_guard<mutex> lockSecond(second->guarded.lock);
+
+        if (!src->canDebit(cents)) {
+            insufficientFunds++;
+            return false;
+        }
+        src->guarded.balanceCents -= cents;
+        dst->guarded.balanceCents += cents;
+        src->record(-cents);
+        dst->record(cents);
+        return true;
+    }
+
+    // Baseline: identical work, but every transfer takes the SAME mutex
+    bool transferGlobalLock(size_t from, size_t to, long long cents) {
+        if (from == to || cents <= 0) return false;
+        Account* src = accounts[from];
+        Account* dst = accounts[to];
+        if (!src->hasPermission(CAN_TRANSFER) || !dst->hasPermission(CAN_DEPOSIT)) {
+            permissionDenied++;
+            return false;
+        }
+        lock_guard<mutex> lock(globalLock);
+        if (!src->canDebit(cents)) {
+            insufficientFunds++;
+            return false;
+        }
+        src->guarded.balanceCents -= cents;
+        dst->guarded.balanceCents += cents;
+        src->record(-cents);
+        dst->record(cents);
+        return true;
+    }
+
+    // Consistent total: lock EVERY account in index order (same order as
+    // transfer, so it cannot deadlock with them), sum, unlock.
+    // Also holds globalLock so it is consistent against the baseline too.
+    long long totalBalance() {
+        lock_guard<mutex> global(globalLock);
+        for (size_t i = 0; i < accounts.size(); i++) accounts[i]->guarded.lock.lock();
+        long long total = 0;
+        for (size_t i = 0; i < accounts.size(); i++) total += accounts[i]->guarded.balanceCents;
+        for (size_t i = accounts.size(); i > 0; i--) accounts[i - 1]->guarded.lock.unlock();
+        return total;
+    }
+
+    // Number of history entries across all accounts (after the threads stop)
+    size_t totalHistory() const {
+        size_t n = 0;
+        for (size_t i = 0; i < accounts.size(); i++) n += accounts[i]->historySize();
+        return n;
+    }
+
+    size_t size() const { return accounts.size(); }
+    long long permissionDeniedCount() const { return permissionDenied.load(); }
+    long long insufficientFundsCount() const { return insufficientFunds.load(); }
+
+    void show(size_t index) {
+        Account* acc = accounts[index];
+        lock_guard<mutex> lock(acc->guarded.lock);
+        long long cents = acc->guarded.balanceCents;
+        long long whole = (cents < 0 ? -cents : cents) / 100;
+        long long part = (cents < 0 ? -cents : cents) % 100;
+        cout << acc->type() << " " << acc->getId() << " " << acc->getName() << ": "
+             << (cents < 0 ? "-" : "") << whole << "." << (part < 10 ? "0" : "") << part
+             << " (" << acc->historySize() << " transactions)" << endl;
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+const size_t ACCOUNTS = 10000;
+const long long OPENING = 100000;                 // 1000.00 each
+const size_t TRANSFERS_PER_THREAD = 500000;
+
+// Random transfers from 'threads' workers while an auditor keeps taking
+// consistent totals. Returns the elapsed time in ms.
+double runStress(unsigned threads, bool useGlobalLock) {
+    Ledger bank;
+    for (size_t i = 0; i < ACCOUNTS; i++) {
+        unsigned perms = CAN_WITHDRAW | CAN_DEPOSIT | CAN_TRANSFER;
+        if (i % 10 == 0) bank.addAccount(new CurrentAccount(2000 + (int)i, "acct" + to_string(i), OPENING, perms | VIP_ACCOUNT, 50000));
+        else bank.addAccount(new SavingsAccount(2000 + (int)i, "acct" + to_string(i), OPENING, perms));
+    }
+    const long long expected = (long long)ACCOUNTS * OPENING;
+
+    atomic<bool> running(true);
+    atomic<int> audits(0);
+    atomic<bool> auditOk(true);
+    thread auditor([&]() {
+        while (running.load()) {
+            if (bank.totalBalance() != expected) auditOk.store(false);
+            audits++;
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+    });
+
+    atomic<long long> succeeded(0);
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            unsigned seed = 12345 + t * 7919;
+            long long ok = 0;
+            for (size_t i = 0; i < TRANSFERS_PER_THREAD; i++) {
+                seed = seed * 1103515245u + 12345u;
+                size_t from = (seed >> 8) % ACCOUNTS;
+                seed = seed * 1103515245u + 12345u;
+                size_t to = (seed >> 8) % ACCOUNTS;
+                long long cents = 1 + (seed >> 4) % 20000;
+                ok += useGlobalLock ? bank.transferGlobalLock(from, to, cents) : bank.transfer(from, to, cents);
+            }
+            succeeded += ok;
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    double ms = millisecondsSince(start);
+    running.store(false);
+    auditor.join();
+
+    long long finalTotal = bank.totalBalance();
+    size_t attempts = threads * TRANSFERS_PER_THREAD;
+    cout << (useGlobalLock ? "\n--- One global mutex ---" : "\n--- Per-account locks (ordered) ---") << endl;
+    cout << "Transfers   : " << succeeded.load() << " committed, " << bank.insufficientFundsCount()
+         << " rejected (insufficient funds), " << bank.permissionDeniedCount() << " rejected (permissions)" << endl;
+    cout << "Time        : " << ms << " ms  (" << (long long)(attempts / (ms / 1000.0)) << " transfers/s)" << endl;
+    cout << "Audits      : " << audits.load() << " mid-run totals, all equal: " << (auditOk.load() ? "YES" : "NO") << endl;
+    cout << "Final total : " << finalTotal << " cents, expected " << expected
+         << "  conserved: " << (finalTotal == expected ? "YES" : "NO") << endl;
+    cout << "History     : " << bank.totalHistory() << " entries, 2 per committed transfer: "
+         << (bank.totalHistory() == 2 * (size_t)succeeded.load() ? "YES" : "NO") << endl;
+    return ms;
+}
+
+int main() {
+    cout << "===== BASIC OPERATIONS =====" << endl;
+    {
+        Ledger bank;
+        size_t ali = bank.addAccount(new SavingsAccount(1001, "Ali", 500000, CAN_WITHDRAW | CAN_DEPOSIT | CAN_TRANSFER));
+        size_t sara = bank.addAccount(new CurrentAccount(1002, "Sara", 800000, CAN_DEPOSIT | CAN_TRANSFER, 100000));
+        size_t omar = bank.addAccount(new SavingsAccount(1003, "Omar", 10000, CAN_DEPOSIT));
+
+        cout << "Ali -> Sara 1500.00     : " << (bank.transfer(ali, sara, 150000) ? "OK" : "DENIED") << endl;
+        cout << "Sara -> Ali 8500.00     : " << (bank.transfer(sara, ali, 850000) ? "OK (overdraft)" : "DENIED") << endl;
+        cout << "Sara -> Ali 2500.00     : " << (bank.transfer(sara, ali, 250000) ? "OK" : "DENIED (overdraft limit)") << endl;
+        cout << "Omar -> Ali 50.00       : " << (bank.transfer(omar, ali, 5000) ? "OK" : "DENIED (no transfer permission)") << endl;
+        cout << "Omar withdraw 10.00     : " << (bank.withdraw(omar, 1000) ? "OK" : "DENIED (no withdraw permission)") << endl;
+        bank.show(ali);
+        bank.show(sara);
+        bank.show(omar);
+        cout << "Total: " << bank.totalBalance() << " cents (started with 1310000)" << endl;
+        cout << "Rejected transfers: " << bank.insufficientFundsCount() << " insufficient funds, "
+             << bank.permissionDeniedCount() << " permissions" << endl;
+    }
+
+    unsigned threads = thread::hardware_concurrency();
+    if (threads < 4) threads = 4;
+    cout << "\n===== STRESS TEST: " << threads << " threads x " << TRANSFERS_PER_THREAD
+         << " random transfers over " << ACCOUNTS << " accounts =====" << endl;
+    double globalMs = runStress(threads, true);
+    double ledgerMs = runStress(threads, false);
+    cout << "\nSpeedup of per-account locks: " << globalMs / ledgerMs << "x on "
+         << thread::hardware_concurrency() << " hardware thread(s)" << endl;
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. The Race in the Unsynchronized Transfer
+       - balance -= amount is read + modify + write
+       - Two threads interleaving those steps lose one update
+       - Sum of all balances drifts: money appears or disappears
+
+    2. Fine-Grained Locking
+       - One mutex per account, not one per bank
+       - Transfer A->B and C->D never touch the same lock: run in parallel
+
+    3. Deadlock-Free Lock Ordering
+       - Always lock the smaller index first
+       - Every thread acquires locks in the same global order -> no cycles
+       - totalBalance() locks ALL accounts in that same order
+
+    4. Atomicity
+       - Both locks are held while checking funds and moving money
+       - Nobody can observe the money "in flight" between the two accounts
+
+    5. False Sharing
+       - alignas(64): each lock + balance owns a cache line
+       - Two cores updating neighbouring accounts do not bounce one line
+
+    6. Exact Conservation
+       - Integer cents: no floating-point rounding in the stress check
+       - Sum after N random transfers must equal the opening sum exactly
+
+    7. Polymorphic Rules Inside the Lock
+       - canDebit(): Savings never below 0, Current down to -overdraft
+       - Permission bits checked with & before taking any lock
+       - Refusals are counted separately: insufficient funds vs permissions
+
+    8. History Inside the Lock
+       - Entries are int64 cents (exact, same unit as the balance)
+       - Stored in 256-entry chunks: a full chunk is never copied, so the
+         time spent holding an account lock stays short and predictable
+*/
@@ -0,0 +1,536 @@
+/*
+    2) PACKED TRANSACTION LOG ([4 bits type][28 bits amount])
+
+    Explanation:
+    - Spec Account keeps vector<double> transactions (8 bytes each) and
+      7_encapsulation.cpp keeps vector<string> built with to_string
+      ("Deposit: +$500.000000" -> 32-byte string object + a heap buffer)
+    - The spec's compressed format fits one transaction in ONE unsigned int:
+          bits 31..28 : type   (1 = Deposit, 2 = Withdrawal, 3 = Transfer out,
+                                4 = Transfer in)
+          bits 27..0  : amount in cents (max 2,684,354.55)
+    - Here that 32-bit word IS the history: in memory (one vector<uint32_t>
+      column per account) and on disk (the same words written as-is)
+    - Encode / decode whole batches with AVX2 (8 words per instruction)
+    - Queries (totals per type, net change, large transactions) run directly
+      on packed words: shift / mask / compare, no decoding into objects
+    - Text is produced only when a human asks to see the history
+
+    Compile with AVX2 enabled for the SIMD kernels:
+        g++ -O2 -mavx2 2_packed_transaction_log.cpp
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ===== PACKED FORMAT =====
+const uint32_t TYPE_SHIFT = 28;
+const uint32_t AMOUNT_MASK = 0x0FFFFFFF;        // Low 28 bits
+
+const uint32_t TX_DEPOSIT = 1;
+const uint32_t TX_WITHDRAWAL = 2;
+const uint32_t TX_TRANSFER_OUT = 3;
+const uint32_t TX_TRANSFER_IN = 4;
+
+inline uint32_t encodeTx(uint32_t type, uint32_t cents) {
+    return (type << TYPE_SHIFT) | (cents & AMOUNT_MASK);
+}
+
+inline uint32_t txType(uint32_t word) {
+    return word >> TYPE_SHIFT;
+}
+
+inline uint32_t txAmount(uint32_t word) {
+    return word & AMOUNT_MASK;
+}
+
+// Deposits and incoming transfers add money, the rest removes it
+inline bool isCredit(uint32_t type) {
+    return type == TX_DEPOSIT || type == TX_TRANSFER_IN;
+}
+
+const char* txName(uint32_t type) {
+    switch (type) {
+        case TX_DEPOSIT: return "Deposit";
+        case TX_WITHDRAWAL: return "Withdrawal";
+        case TX_TRANSFER_OUT: return "Transfer out";
+        case TX_TRANSFER_IN: return "Transfer in";
+        default: return "Unknown";
+    }
+}
+
+// ===== BATCH KERNELS =====
+// encodeBatch: types[i] + cents[i] -> words[i]. Returns false (and encodes
+// nothing) if any type is not 1..4 or any amount does not fit in 28 bits.
+bool encodeBatch(const uint8_t* types, const uint32_t* cents, uint32_t* words, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i limit = _mm256_set1_epi32((int)AMOUNT_MASK);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i typeLimit = _mm256_set1_epi32((int)(TX_TRANSFER_IN - 1));
+    __m256i bad = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(cents + i));
+        __m256i t = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(types + i))), one);
+        // Unsigned x > limit  <=>  max(x, limit) != limit  (type 0 wraps to 0xFFFFFFFF)
+        bad = _mm256_or_si256(bad, _mm256_xor_si256(_mm256_max_epu32(a, limit), limit));
+        bad = _mm256_or_si256(bad, _mm256_xor_si256(_mm256_max_epu32(t, typeLimit), typeLimit));
+    }
+    if (!_mm256_testz_si256(bad, bad)) return false;
+#endif
+    for (; i < n; i++) {
+        if (cents[i] > AMOUNT_MASK || types[i] < TX_DEPOSIT || types[i] > TX_TRANSFER_IN) return false;
+    }
+
+    i = 0;
+#if defined(__AVX2__)
+    for (; i + 8 <= n; i += 8) {
+        __m256i t = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(types + i)));
+        __m256i a = _mm256_loadu_si256((const __m256i*)(cents + i));
+        _mm256_storeu_si256((__m256i*)(words + i), _mm256_or_si256(_mm256_slli_epi32(t, TYPE_SHIFT), a));
+    }
+#endif
+    for (; i < n; i++) words[i] = encodeTx(types[i], cents[i]);
+    return true;
+}
+
+void decodeBatch(const uint32_t* words, uint8_t* types, uint32_t* cents, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i mask = _mm256_set1_epi32((int)AMOUNT_MASK);
+    const __m256i narrow = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    for (; i + 8 <= n; i += 8) {
+        __m256i w = _mm256_loadu_si256((const __m256i*)(words + i));
+        _mm256_storeu_si256((__m256i*)(cents + i), _mm256_and_si256(w, mask));
+        // 8 x 32-bit types -> 8 bytes: pick byte 0 of each lane, then join the halves
+        __m256i t = _mm256_shuffle_epi8(_mm256_srli_epi32(w, TYPE_SHIFT), narrow);
+        uint32_t lo = (uint32_t)_mm256_extract_epi32(t, 0);
+        uint32_t hi = (uint32_t)_mm256_extract_epi32(t, 4);
+        memcpy(types + i, &lo, 4);
+        memcpy(types + i + 4, &hi, 4);
+    }
+#endif
+    for (; i < n; i++) {
+        types[i] = (uint8_t)txType(words[i]);
+        cents[i] = txAmount(words[i]);
+    }
+}
+
+// ===== QUERIES ON PACKED DATA =====
+struct TxSummary {
+    uint64_t totalCents[16];      // Sum of amounts per type
+    uint64_t count[16];           // Transactions per type
+
+    long long netCents() const {
+        return (long long)(totalCents[TX_DEPOSIT] + totalCents[TX_TRANSFER_IN]) -
+               (long long)(totalCents[TX_WITHDRAWAL] + totalCents[TX_TRANSFER_OUT]);
+    }
+};
+
+// Scalar reference: one word at a time
+TxSummary summarizeScalar(const uint32_t* words, size_t n) {
+    TxSummary s;
+    memset(&s, 0, sizeof(s));
+    for (size_t i = 0; i < n; i++) {
+        s.totalCents[txType(words[i])] += txAmount(words[i]);
+        s.count[txType(words[i])]++;
+    }
+    return s;
+}
+
+#if defined(__AVX2__)
+// Add the lanes of 'amounts' selected by 'mask' into two 4 x 64-bit sums
+inline void addMasked(__m256i amounts, __m256i mask, __m256i& sumLo, __m256i& sumHi) {
+    __m256i picked = _mm256_and_si256(amounts, mask);
+    sumLo = _mm256_add_epi64(sumLo, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(picked)));
+    sumHi = _mm256_add_epi64(sumHi, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(picked, 1)));
+}
+
+uint64_t horizontalSum(__m256i lo, __m256i hi) {
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(lo, hi));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+#endif
+
+// SIMD: 8 words per step, one compare per type, 64-bit sums (no overflow).
+// Words always hold types 1..4 (append / encodeBatch reject anything else).
+TxSummary summarize(const uint32_t* words, size_t n) {
+    TxSummary s;
+    memset(&s, 0, sizeof(s));
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i mask = _mm256_set1_epi32((int)AMOUNT_MASK);
+    __m256i sumLo[4], sumHi[4];
+    uint64_t counts[4] = {0, 0, 0, 0};
+    for (int t = 0; t < 4; t++) sumLo[t] = sumHi[t] = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i w = _mm256_loadu_si256((const __m256i*)(words + i));
+        __m256i type = _mm256_srli_epi32(w, TYPE_SHIFT);
+        __m256i amount = _mm256_and_si256(w, mask);
+        for (int t = 0; t < 4; t++) {
+            __m256i hit = _mm256_cmpeq_epi32(type, _mm256_set1_epi32(t + 1));
+            addMasked(amount, hit, sumLo[t], sumHi[t]);
+            counts[t] += (uint64_t)__builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+        }
+    }
+    for (int t = 0; t < 4; t++) {
+        s.totalCents[t + 1] = horizontalSum(sumLo[t], sumHi[t]);
+        s.count[t + 1] = counts[t];
+    }
+#endif
+    for (; i < n; i++) {
+        s.totalCents[txType(words[i])] += txAmount(words[i]);
+        s.count[txType(words[i])]++;
+    }
+    return s;
+}
+
+// Count transactions of 'type' with amount >= minCents (e.g. large withdrawals)
+size_t countAtLeast(const uint32_t* words, size_t n, uint32_t type, uint32_t minCents) {
+    if (minCents > AMOUNT_MASK) return 0;       // No 28-bit amount is that large (and encodeTx would wrap it)
+    // Type is in the high bits, so one range check covers both conditions:
+    // encode(type, minCents) <= word <= encode(type, MAX)
+    uint32_t lo = encodeTx(type, minCents);
+    uint32_t hi = encodeTx(type, AMOUNT_MASK);
+    size_t count = 0, i = 0;
+#if defined(__AVX2__)
+    // Unsigned range check via signed compare after flipping the sign bit.
+    // lo - 1 and hi + 1 must not wrap, which holds for every type 1..14.
+    if (lo > 0 && hi < 0xFFFFFFFFu) {
+        const __m256i flip = _mm256_set1_epi32((int)0x80000000u);
+        const __m256i below = _mm256_set1_epi32((int)((lo - 1) ^ 0x80000000u));
+        const __m256i above = _mm256_set1_epi32((int)((hi + 1) ^ 0x80000000u));
+        for (; i + 8 <= n; i += 8) {
+            __m256i w = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(words + i)), flip);
+            __m256i in = _mm256_and_si256(_mm256_cmpgt_epi32(w, below), _mm256_cmpgt_epi32(above, w));
+            count += (size_t)__builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(in)));
+        }
+    }
+#endif
+    for (; i < n; i++) count += (words[i] - lo) <= (hi - lo);
+    return count;
+}
+
+// ===== PACKED LOG (one column of 32-bit words) =====
+class PackedLog {
+private:
+    vector<uint32_t> words;
+
+public:
+    bool append(uint32_t type, long long cents) {
+        if (type < TX_DEPOSIT || type > TX_TRANSFER_IN) {
+            cout << "Error: unknown transaction type " << type << endl;
+            return false;
+        }
+        if (cents < 0 || cents > (long long)AMOUNT_MASK) {
+            cout << "Error: amount " << cents << " cents does not fit in 28 bits" << endl;
+            return false;
+        }
+        words.push_back(encodeTx(type, (uint32_t)cents));
+        return true;
+    }
+
+    // Undo the last append (the other half of a transfer failed)
+    void dropLast() {
+        if (!words.empty()) words.pop_back();
+    }
+
+    bool appendBatch(const uint8_t* types, const uint32_t* cents, size_t n) {
+        size_t old = words.size();
+        words.resize(old + n);
+        if (!encodeBatch(types, cents, words.data() + old, n)) {
+            words.resize(old);
+            cout << "Error: batch has an unknown type or an amount that does not fit in 28 bits" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // ---- On disk: header + the same 32-bit words ----
+    struct FileHeader {
+        char magic[4];            // "TXLG"
+        uint32_t version;
+        uint64_t count;
+    };
+
+    bool saveToFile(const string& path) const {
+        ofstream out(path, ios::binary | ios::trunc);
+        if (!out) {
+            cout << "Error: cannot open " << path << endl;
+            return false;
+        }
+        FileHeader h;
+        memcpy(h.magic, "TXLG", 4);
+        h.version = 1;
+        h.count = words.size();
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)words.data(), (streamsize)(words.size() * sizeof(uint32_t)));
+        return (bool)out;
+    }
+
+    // Header count is checked against the real file size BEFORE allocating,
+    // and every word's type nibble is checked: a corrupt file loads nothing
+    bool loadFromFile(const string& path) {
+        ifstream in(path, ios::binary | ios::ate);
+        FileHeader h;
+        streamoff fileSize = in ? (streamoff)in.tellg() : -1;
+        in.seekg(0);
+        if (!in || fileSize < (streamoff)sizeof(h) || !in.read((char*)&h, sizeof(h)) ||
+            memcmp(h.magic, "TXLG", 4) != 0 || h.version != 1) {
+            cout << "Error: " << path << " is not a transaction log" << endl;
+            return false;
+        }
+        uint64_t payload = (uint64_t)fileSize - sizeof(h);
+        if (payload % sizeof(uint32_t) != 0 || h.count != payload / sizeof(uint32_t)) {
+            cout << "Error: " << path << " holds " << payload / sizeof(uint32_t) << " words, header says "
+                 << h.count << " (truncated or corrupt)" << endl;
+            return false;
+        }
+        vector<uint32_t> loaded(h.count);
+        if (!in.read((char*)loaded.data(), (streamsize)payload)) {
+            cout << "Error: " << path << " is truncated" << endl;
+            return false;
+        }
+        for (size_t i = 0; i < loaded.size(); i++) {
+            uint32_t type = txType(loaded[i]);
+            if (type < TX_DEPOSIT || type > TX_TRANSFER_IN) {
+                cout << "Error: " << path << " record " << i << " has unknown type " << type << endl;
+                return false;
+            }
+        }
+        words.swap(loaded);
+        return true;
+    }
+
+    // Formatting happens only here, never when recording
+    void display(size_t limit) const {
+        for (size_t i = 0; i < words.size() && i < limit; i++) {
+            uint32_t cents = txAmount(words[i]);
+            cout << "  " << txName(txType(words[i])) << ": " << (isCredit(txType(words[i])) ? "+$" : "-$")
+                 << cents / 100 << "." << (cents % 100 < 10 ? "0" : "") << cents % 100 << endl;
+        }
+    }
+
+    const uint32_t* data() const { return words.data(); }
+    size_t size() const { return words.size(); }
+    size_t bytes() const { return words.capacity() * sizeof(uint32_t); }
+};
+
+// ===== ACCOUNT USING THE PACKED LOG =====
+const unsigned CAN_WITHDRAW = 1;
+const unsigned CAN_DEPOSIT = 2;
+const unsigned CAN_TRANSFER = 4;
+
+class Account {
+protected:
+    int accountId;
+    string name;
+    long long balanceCents;
+    unsigned int permissions;
+    PackedLog transactions;       // Replaces vector<double>
+
+public:
+    Account(int id, string n, long long cents, unsigned perms)
+        : accountId(id), name(n), balanceCents(cents), permissions(perms) {}
+
+    virtual ~Account() {}
+
+    bool deposit(long long cents) {
+        if (!(permissions & CAN_DEPOSIT) || cents <= 0) return false;
+        if (!transactions.append(TX_DEPOSIT, cents)) return false;
+        balanceCents += cents;
+        return true;
+    }
+
+    bool withdraw(long long cents) {
+        if (!(permissions & CAN_WITHDRAW) || cents <= 0 || cents > balanceCents) return false;
+        if (!transactions.append(TX_WITHDRAWAL, cents)) return false;
+        balanceCents -= cents;
+        return true;
+    }
+
+    // Both records are written before any balance changes: if either side
+    // cannot be recorded, nothing happens
+    bool transferTo(Account& other, long long cents) {
+        if (!(permissions & CAN_TRANSFER) || cents <= 0 || cents > balanceCents) return false;
+        if (!(other.permissions & CAN_DEPOSIT)) return false;
+        if (!transactions.append(TX_TRANSFER_OUT, cents)) return false;
+        if (!other.transactions.append(TX_TRANSFER_IN, cents)) {
+            transactions.dropLast();
+            return false;
+        }
+        balanceCents -= cents;
+        other.balanceCents += cents;
+        return true;
+    }
+
+    const PackedLog& history() const { return transactions; }
+    long long balance() const { return balanceCents; }
+    string getName() const { return name; }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== ONE ACCOUNT =====" << endl;
+    Account ali(1001, "Ali", 0, CAN_WITHDRAW | CAN_DEPOSIT | CAN_TRANSFER);
+    Account sara(1002, "Sara", 0, CAN_DEPOSIT);
+    Account omar(1003, "Omar", 0, CAN_WITHDRAW);
+    ali.deposit(500000);
+    ali.withdraw(12550);
+    ali.transferTo(sara, 20000);
+    ali.deposit(300000000);           // 3,000,000.00 does not fit in 28 bits
+    bool toOmar = ali.transferTo(omar, 10000);
+    cout << "Transfer to an account without CAN_DEPOSIT refused: " << (!toOmar && omar.history().size() == 0 ? "YES" : "NO") << endl;
+    cout << "Ali history (" << ali.history().size() << " words, " << ali.history().size() * 4 << " bytes):" << endl;
+    ali.history().display(10);
+    TxSummary one = summarize(ali.history().data(), ali.history().size());
+    cout << "Net from packed words: " << one.netCents() << " cents, balance: " << ali.balance() << " cents" << endl;
+    cout << "Word for the first deposit: 0x" << hex << ali.history().data()[0] << dec << endl;
+
+    const size_t N = 20000000;
+    cout << "\n===== " << N << " TRANSACTIONS =====" << endl;
+    vector<uint8_t> types(N);
+    vector<uint32_t> cents(N);
+    unsigned seed = 99;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        types[i] = (uint8_t)(1 + (seed >> 12) % 4);
+        cents[i] = (seed >> 4) % 5000000;
+    }
+
+    // Memory of the three representations
+    {
+        const size_t SAMPLE = 1000000;
+        vector<string> strings;
+        strings.reserve(SAMPLE);
+        auto start = chrono::steady_clock::now();
+        size_t heapBytes = 0;
+        for (size_t i = 0; i < SAMPLE; i++) {
+            strings.push_back(string(txName(types[i])) + ": " + (isCredit(types[i]) ? "+$" : "-$") + to_string(cents[i] / 100.0));
+            if (strings.back().capacity() > 15) heapBytes += strings.back().capacity() + 1;
+        }
+        double stringMs = millisecondsSince(start);
+        size_t stringBytes = strings.capacity() * sizeof(string) + heapBytes;
+        cout << "vector<string>   : " << stringBytes / SAMPLE << " bytes/tx, " << stringMs * N / SAMPLE
+             << " ms to record " << N << " (extrapolated)" << endl;
+        cout << "vector<double>   : " << sizeof(double) << " bytes/tx" << endl;
+        cout << "packed uint32_t  : " << sizeof(uint32_t) << " bytes/tx  ("
+             << (double)stringBytes / SAMPLE / sizeof(uint32_t) << "x smaller than strings)" << endl;
+    }
+
+    // Encode into buffers that are already allocated, so only the kernel is timed
+    vector<uint32_t> simdWords(N), scalarWords(N);
+    auto start = chrono::steady_clock::now();
+    encodeBatch(types.data(), cents.data(), simdWords.data(), N);
+    double encodeMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) scalarWords[i] = encodeTx(types[i], cents[i]);
+    double scalarEncodeMs = millisecondsSince(start);
+    cout << "\nEncode batch     : " << encodeMs << " ms (scalar loop " << scalarEncodeMs << " ms), same words: "
+         << (simdWords == scalarWords ? "YES" : "NO") << endl;
+
+    PackedLog log;
+    log.appendBatch(types.data(), cents.data(), N);
+
+    vector<uint8_t> backTypes(N);
+    vector<uint32_t> backCents(N);
+    start = chrono::steady_clock::now();
+    decodeBatch(log.data(), backTypes.data(), backCents.data(), N);
+    double decodeMs = millisecondsSince(start);
+    cout << "Decode batch     : " << decodeMs << " ms, round trip exact: "
+         << (backTypes == types && backCents == cents ? "YES" : "NO") << endl;
+
+    start = chrono::steady_clock::now();
+    TxSummary ref = summarizeScalar(log.data(), N);
+    double scalarMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    TxSummary fast = summarize(log.data(), N);
+    double simdMs = millisecondsSince(start);
+    bool same = memcmp(&ref, &fast, sizeof(ref)) == 0;
+    cout << "\nTotals per type  : scalar " << scalarMs << " ms, SIMD " << simdMs << " ms, match: " << (same ? "YES" : "NO") << endl;
+    for (uint32_t t = TX_DEPOSIT; t <= TX_TRANSFER_IN; t++) {
+        cout << "  " << txName(t) << ": " << fast.count[t] << " tx, " << fast.totalCents[t] / 100 << " total" << endl;
+    }
+    cout << "  Net change: " << fast.netCents() / 100 << endl;
+
+    start = chrono::steady_clock::now();
+    size_t large = countAtLeast(log.data(), N, TX_WITHDRAWAL, 4000000);
+    double largeMs = millisecondsSince(start);
+    size_t largeRef = 0;
+    for (size_t i = 0; i < N; i++) largeRef += (types[i] == TX_WITHDRAWAL && cents[i] >= 4000000);
+    cout << "Withdrawals >= 40000.00: " << large << " in " << largeMs << " ms, match: " << (large == largeRef ? "YES" : "NO") << endl;
+    cout << "Withdrawals >= 2,684,355.56 (above the 28-bit max, would wrap to 1.00): "
+         << countAtLeast(log.data(), N, TX_WITHDRAWAL, AMOUNT_MASK + 101) << endl;
+
+    const string path = "transactions.txlg";
+    start = chrono::steady_clock::now();
+    log.saveToFile(path);
+    PackedLog loaded;
+    loaded.loadFromFile(path);
+    double ioMs = millisecondsSince(start);
+    cout << "\nSave + load " << N * 4 / (1 << 20) << " MB: " << ioMs << " ms, identical: "
+         << (loaded.size() == N && memcmp(loaded.data(), log.data(), N * 4) == 0 ? "YES" : "NO") << endl;
+
+    // Corrupt header: count claims far more words than the file holds
+    {
+        fstream f(path, ios::in | ios::out | ios::binary);
+        uint64_t bogus = 1ULL << 60;
+        f.seekp(8);
+        f.write((const char*)&bogus, sizeof(bogus));
+    }
+    PackedLog corrupt;
+    bool rejected = !corrupt.loadFromFile(path);
+    cout << "Corrupt header rejected without allocating: " << (rejected && corrupt.size() == 0 ? "YES" : "NO") << endl;
+    remove(path.c_str());
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Bit Packing
+       - word = (type << 28) | amount
+       - type = word >> 28, amount = word & 0x0FFFFFFF
+       - Amount in integer cents: exact, max 2,684,354.55 per transaction
+
+    2. One Representation Everywhere
+       - Memory: vector<uint32_t> (4 bytes per transaction)
+       - Disk: 16-byte header + the same words, no parsing on load
+       - Text only in display(), never while recording
+
+    3. SIMD Encode / Decode
+       - _mm256_cvtepu8_epi32 widens 8 type bytes to 8 ints
+       - Shift + OR builds 8 words at once
+       - Overflow check for the whole batch before writing anything
+
+    4. Queries Without Decoding
+       - Type compare on (word >> 28), sums on (word & mask)
+       - Amounts widened to 64-bit lanes: billions of cents cannot overflow
+       - "type T and amount >= X" is ONE unsigned range check on the word,
+         because the type sits in the highest bits
+       - X above the 28-bit maximum returns 0 at once (it cannot be encoded)
+
+    5. Unsigned Compare With Signed Instructions
+       - AVX2 only has signed 32-bit compares
+       - XOR with 0x80000000 maps unsigned order onto signed order
+
+    6. Memory
+       - string history: ~60 bytes per entry (object + heap buffer)
+       - packed: 4 bytes -> many more transactions per cache line
+*/
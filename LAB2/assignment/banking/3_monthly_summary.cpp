@@ -0,0 +1,337 @@
+/*
+    3) SIMD MONTHLY SUMMARY (double monthlyTotals[12] at Memory Speed)
+
+    Explanation:
+    - Spec: loop over every transaction, find its month, add to deposits or
+      withdrawals -> one branchy step per transaction
+    - Here transactions are two parallel columns:
+          uint32_t word[i]  -> packed [4 bits type][28 bits cents] (2_packed_transaction_log.cpp)
+          uint32_t time[i]  -> Unix timestamp (seconds)
+    - Month boundaries are precomputed once: first second of every month
+    - Logs are appended in time order, so almost every chunk of 2048
+      transactions belongs to ONE month (the month of its newest row):
+          AVX2: 8 rows at a time, "first <= ts < next" -> lane mask
+                masked sums of credits and of all amounts (withdrawals = rest)
+          the few late / other-month rows (mask bits = 0) are added one by one
+      -> one pass, a handful of instructions per 8 rows: memory-bandwidth bound
+    - Multithreaded: each thread summarizes its own slice into its own
+      monthlyTotals arrays, then the arrays are merged (12 additions each)
+
+    Compile with AVX2 enabled for the SIMD kernels:
+        g++ -O2 -mavx2 -pthread 3_monthly_summary.cpp
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ===== PACKED FORMAT (same as 2_packed_transaction_log.cpp) =====
+const uint32_t TYPE_SHIFT = 28;
+const uint32_t AMOUNT_MASK = 0x0FFFFFFF;
+
+const uint32_t TX_DEPOSIT = 1;
+const uint32_t TX_WITHDRAWAL = 2;
+const uint32_t TX_TRANSFER_OUT = 3;
+const uint32_t TX_TRANSFER_IN = 4;
+
+inline uint32_t encodeTx(uint32_t type, uint32_t cents) {
+    return (type << TYPE_SHIFT) | (cents & AMOUNT_MASK);
+}
+
+// Deposits and incoming transfers add money, withdrawals and outgoing transfers remove it
+inline bool isCredit(uint32_t word) {
+    uint32_t type = word >> TYPE_SHIFT;
+    return type == TX_DEPOSIT || type == TX_TRANSFER_IN;
+}
+
+// ===== CALENDAR =====
+// Days since 1970-01-01 for a civil date (proleptic Gregorian)
+long long daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// boundary[m] = first second of month m (0..11), boundary[12] = first second of next year
+struct MonthBoundaries {
+    int year;
+    uint32_t boundary[13];
+
+    MonthBoundaries(int y) : year(y) {
+        for (int m = 0; m < 12; m++) boundary[m] = (uint32_t)(daysFromCivil(y, m + 1, 1) * 86400);
+        boundary[12] = (uint32_t)(daysFromCivil(y + 1, 1, 1) * 86400);
+    }
+
+    // -1 if the timestamp is outside the year
+    int monthOf(uint32_t ts) const {
+        if (ts < boundary[0] || ts >= boundary[12]) return -1;
+        int m = 0;
+        while (ts >= boundary[m + 1]) m++;
+        return m;
+    }
+};
+
+// ===== RESULT =====
+// Integer cents, so thread partials merge exactly in any order
+struct alignas(64) MonthlySummary {
+    long long deposits[12];
+    long long withdrawals[12];
+    long long outsideYear;          // Transactions not in the report year
+
+    MonthlySummary() {
+        clear();
+    }
+
+    void clear() {
+        memset(deposits, 0, sizeof(deposits));
+        memset(withdrawals, 0, sizeof(withdrawals));
+        outsideYear = 0;
+    }
+
+    long long net(int m) const {
+        return deposits[m] - withdrawals[m];
+    }
+
+    void merge(const MonthlySummary& other) {
+        for (int m = 0; m < 12; m++) {
+            deposits[m] += other.deposits[m];
+            withdrawals[m] += other.withdrawals[m];
+        }
+        outsideYear += other.outsideYear;
+    }
+
+    // Spec format: double monthlyTotals[12] = net change per month
+    void toMonthlyTotals(double monthlyTotals[12]) const {
+        for (int m = 0; m < 12; m++) monthlyTotals[m] = net(m) / 100.0;
+    }
+
+    bool operator==(const MonthlySummary& o) const {
+        return memcmp(deposits, o.deposits, sizeof(deposits)) == 0 &&
+               memcmp(withdrawals, o.withdrawals, sizeof(withdrawals)) == 0 && outsideYear == o.outsideYear;
+    }
+};
+
+// ===== BASELINE: one transaction at a time =====
+void summarizeLoop(const uint32_t* words, const uint32_t* times, size_t n,
+                   const MonthBoundaries& cal, MonthlySummary& out) {
+    for (size_t i = 0; i < n; i++) {
+        int m = cal.monthOf(times[i]);
+        if (m < 0) {
+            out.outsideYear++;
+            continue;
+        }
+        long long cents = words[i] & AMOUNT_MASK;
+        if (isCredit(words[i])) out.deposits[m] += cents;
+        else out.withdrawals[m] += cents;
+    }
+}
+
+// ===== VECTORIZED KERNEL =====
+const size_t CHUNK = 2048;
+
+#if defined(__AVX2__)
+inline uint64_t horizontalSum(__m256i v) {
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+inline __m256i widenAdd(__m256i sum, __m256i v) {
+    sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+    return _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+#endif
+
+// One chunk, assuming most rows fall in month m. Rows in m are summed with
+// SIMD (credits + all amounts); the rare rows outside m are handled one by one.
+void summarizeChunk(const uint32_t* words, const uint32_t* times, size_t n, int m,
+                    const MonthBoundaries& cal, MonthlySummary& out) {
+    uint64_t credit = 0, total = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i mask = _mm256_set1_epi32((int)AMOUNT_MASK);
+    const __m256i depositType = _mm256_set1_epi32((int)TX_DEPOSIT);
+    const __m256i transferInType = _mm256_set1_epi32((int)TX_TRANSFER_IN);
+    // Unsigned  first <= ts < next  through the sign-flip trick
+    const __m256i flip = _mm256_set1_epi32((int)0x80000000u);
+    const __m256i beforeMonth = _mm256_set1_epi32((int)((cal.boundary[m] - 1) ^ 0x80000000u));
+    const __m256i nextMonth = _mm256_set1_epi32((int)(cal.boundary[m + 1] ^ 0x80000000u));
+    __m256i creditSum = _mm256_setzero_si256(), totalSum = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i w = _mm256_loadu_si256((const __m256i*)(words + i));
+        __m256i t = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(times + i)), flip);
+        __m256i inMonth = _mm256_and_si256(_mm256_cmpgt_epi32(t, beforeMonth), _mm256_cmpgt_epi32(nextMonth, t));
+        __m256i type = _mm256_srli_epi32(w, TYPE_SHIFT);
+        __m256i amount = _mm256_and_si256(_mm256_and_si256(w, mask), inMonth);
+        __m256i isCreditLane = _mm256_or_si256(_mm256_cmpeq_epi32(type, depositType),
+                                               _mm256_cmpeq_epi32(type, transferInType));
+        totalSum = widenAdd(totalSum, amount);
+        creditSum = widenAdd(creditSum, _mm256_and_si256(amount, isCreditLane));
+
+        unsigned outside = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(inMonth)) & 0xFF;
+        while (outside) {
+            int lane = __builtin_ctz(outside);
+            outside &= outside - 1;
+            summarizeLoop(words + i + lane, times + i + lane, 1, cal, out);
+        }
+    }
+    credit = horizontalSum(creditSum);
+    total = horizontalSum(totalSum);
+#endif
+    for (; i < n; i++) {
+        if (times[i] >= cal.boundary[m] && times[i] < cal.boundary[m + 1]) {
+            uint32_t cents = words[i] & AMOUNT_MASK;
+            total += cents;
+            if (isCredit(words[i])) credit += cents;
+        } else {
+            summarizeLoop(words + i, times + i, 1, cal, out);
+        }
+    }
+    out.deposits[m] += (long long)credit;
+    out.withdrawals[m] += (long long)(total - credit);
+}
+
+// The chunk's month is taken from its LAST row: in an append-only log the
+// newest row is in the current month, late rows are the exceptions
+void summarize(const uint32_t* words, const uint32_t* times, size_t n,
+               const MonthBoundaries& cal, MonthlySummary& out) {
+    for (size_t start = 0; start < n; start += CHUNK) {
+        size_t len = n - start < CHUNK ? n - start : CHUNK;
+        int m = cal.monthOf(times[start + len - 1]);
+        if (m < 0) m = cal.monthOf(times[start]);
+        if (m >= 0) summarizeChunk(words + start, times + start, len, m, cal, out);
+        else summarizeLoop(words + start, times + start, len, cal, out);
+    }
+}
+
+// ===== MULTITHREADED: per-thread monthlyTotals, then merge =====
+void summarizeParallel(const uint32_t* words, const uint32_t* times, size_t n,
+                       const MonthBoundaries& cal, MonthlySummary& out, unsigned threads) {
+    vector<MonthlySummary> partial(threads);      // alignas(64): no false sharing
+    vector<thread> workers;
+    size_t slice = (n + threads - 1) / threads;
+    slice = (slice + CHUNK - 1) / CHUNK * CHUNK;  // Slices start on chunk boundaries
+    for (unsigned t = 0; t < threads; t++) {
+        size_t begin = t * slice;
+        if (begin >= n) break;
+        size_t end = begin + slice < n ? begin + slice : n;
+        workers.push_back(thread([&, t, begin, end]() {
+            summarize(words + begin, times + begin, end - begin, cal, partial[t]);
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    for (unsigned t = 0; t < threads; t++) out.merge(partial[t]);
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const size_t N = 32000000;
+    const MonthBoundaries cal(2025);
+    cout << "===== " << N << " transactions in " << cal.year << " (+ a few from other years) =====" << endl;
+
+    // Time-ordered log with ~1% late-arriving rows (timestamps a few days old)
+    vector<uint32_t> words(N), times(N);
+    unsigned seed = 31;
+    uint32_t span = cal.boundary[12] - cal.boundary[0];
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t ts = cal.boundary[0] + (uint32_t)((double)i / N * span);
+        if ((seed >> 16) % 100 == 0) ts -= (seed >> 4) % (5 * 86400);
+        if (i < 1000) ts = cal.boundary[0] - 1 - (uint32_t)i;               // Last year
+        times[i] = ts;
+        words[i] = encodeTx(1 + (seed >> 12) % 4, (seed >> 4) % 1000000);
+    }
+    double megabytes = N * 8.0 / (1 << 20);
+
+    MonthlySummary loop;
+    auto start = chrono::steady_clock::now();
+    summarizeLoop(words.data(), times.data(), N, cal, loop);
+    double loopMs = millisecondsSince(start);
+
+    MonthlySummary simd;
+    start = chrono::steady_clock::now();
+    summarize(words.data(), times.data(), N, cal, simd);
+    double simdMs = millisecondsSince(start);
+
+    unsigned threads = thread::hardware_concurrency();
+    if (threads < 2) threads = 2;
+    MonthlySummary parallel;
+    start = chrono::steady_clock::now();
+    summarizeParallel(words.data(), times.data(), N, cal, parallel, threads);
+    double parallelMs = millisecondsSince(start);
+
+    // Memory bandwidth reference: just sum both columns
+    start = chrono::steady_clock::now();
+    uint64_t touch = 0;
+    for (size_t i = 0; i < N; i++) touch += words[i] + times[i];
+    double readMs = millisecondsSince(start);
+
+    const char* names[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    double monthlyTotals[12];
+    parallel.toMonthlyTotals(monthlyTotals);
+    cout << fixed << setprecision(2);
+    cout << "Month      Deposits        Withdrawals     Net (monthlyTotals)" << endl;
+    for (int m = 0; m < 12; m++) {
+        cout << names[m] << "  " << setw(16) << parallel.deposits[m] / 100.0 << setw(16)
+             << parallel.withdrawals[m] / 100.0 << setw(16) << monthlyTotals[m] << endl;
+    }
+    cout << "Outside " << cal.year << ": " << parallel.outsideYear << " transactions" << endl;
+    cout << setprecision(1);
+
+    cout << "\nPer-transaction loop : " << loopMs << " ms (" << megabytes / (loopMs / 1000) << " MB/s)" << endl;
+    cout << "Vectorized, 1 thread : " << simdMs << " ms (" << megabytes / (simdMs / 1000) << " MB/s), same result: "
+         << (simd == loop ? "YES" : "NO") << endl;
+    cout << "Vectorized, " << threads << " threads: " << parallelMs << " ms (" << megabytes / (parallelMs / 1000)
+         << " MB/s), same result: " << (parallel == loop ? "YES" : "NO") << endl;
+    cout << "Plain read of columns: " << readMs << " ms (" << megabytes / (readMs / 1000) << " MB/s)"
+         << (touch == 0 ? " " : "") << endl;
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Month Boundaries Instead of Calendar Math
+       - boundary[0..12] = first second of each month (+ next year)
+       - "Is ts in month m?" = two compares, no division or date conversion
+
+    2. One Month per Chunk
+       - Chunk of 2048 rows takes the month of its newest row
+       - AVX2 compares 8 timestamps against that month -> mask
+       - Only two sums are needed: credits and all amounts
+         (withdrawals = total - credits)
+
+    3. Exceptions
+       - Late-arriving rows and chunks that cross a month boundary
+       - movemask gives the lanes outside the month, each added one by one
+       - Rare, so the cost stays close to a plain read of the columns
+
+    4. Exact Totals
+       - Integer cents, 64-bit accumulators
+       - 28-bit amounts widened to 64-bit lanes before adding
+
+    5. Per-Thread monthlyTotals
+       - Each thread owns a 64-byte aligned MonthlySummary (no false sharing)
+       - Merge = 24 additions per thread, order does not matter
+
+    6. Memory-Bandwidth Bound
+       - Each transaction is read once: 8 bytes (word + timestamp)
+       - Compare with the "plain read" line: the report costs about a read
+*/
@@ -0,0 +1,822 @@
+/*
+    4) BINARY APPEND-ONLY ACCOUNT JOURNAL (O(1) Persistence per Transaction)
+
+    Explanation:
+    - Spec saveToFile() rewrites the whole "ACCOUNT Savings / TRANSACTIONS"
+      text file -> persisting ONE deposit costs the size of the WHOLE bank
+    - Journal: every transaction appends ONE 16-byte binary record
+          [uint32 crc][uint32 accountId][uint32 packed word][uint32 timestamp]
+      (packed word = [4 bits type][28 bits cents], 2_packed_transaction_log.cpp)
+    - Per-account offset index: where each account's records are in the files,
+      so one account's history is read without scanning the journal
+    - Durability window: appends go to a memory buffer; a background thread
+      writes + fsyncs the buffer every N ms (one fsync for thousands of records)
+      -> a crash loses at most the last N ms; window 0 = fsync on every append
+    - Compaction: fold everything into a binary snapshot (temp + rename),
+      then start an EMPTY journal with the next generation number
+    - Startup: load the snapshot, replay ONLY the journal tail written after it
+      -> a snapshot that fails validation stops startup: the journal is left
+         untouched instead of being mistaken for a stale one and truncated
+    - Torn records (crash mid-write) are detected by the CRC and cut off
+
+    POSIX only (open / write / pread / fsync / ftruncate).
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+// ===== CRC32 (bitwise, table-driven) =====
+uint32_t crcTable[256];
+
+void initCrcTable() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        crcTable[i] = c;
+    }
+}
+
+uint32_t crc32(const char* data, size_t len) {
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) c = crcTable[(c ^ (unsigned char)data[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+// ===== PACKED TRANSACTION WORD =====
+const uint32_t TYPE_SHIFT = 28;
+const uint32_t AMOUNT_MASK = 0x0FFFFFFF;
+const uint32_t TX_DEPOSIT = 1;
+const uint32_t TX_WITHDRAWAL = 2;
+const uint32_t REC_OPEN = 15;            // Journal-only: account opened
+
+inline uint32_t encodeTx(uint32_t type, uint32_t cents) {
+    return (type << TYPE_SHIFT) | (cents & AMOUNT_MASK);
+}
+
+// ===== ACCOUNTS =====
+const unsigned CAN_WITHDRAW = 1;
+const unsigned CAN_DEPOSIT = 2;
+const unsigned CAN_TRANSFER = 4;
+const uint8_t KIND_SAVINGS = 0;
+const uint8_t KIND_CURRENT = 1;
+
+class Account {
+public:
+    uint32_t accountId;
+    string name;
+    unsigned permissions;
+    long long balanceCents;
+
+    // Offset index: history = snapshot words + journal records
+    uint64_t snapshotOffset;            // First history word in the snapshot file
+    uint32_t snapshotCount;
+    vector<uint64_t> journalOffsets;    // One per record in the current journal
+
+    Account(uint32_t id, string n, unsigned perms, long long cents)
+        : accountId(id), name(n), permissions(perms), balanceCents(cents), snapshotOffset(0), snapshotCount(0) {}
+
+    virtual ~Account() {}
+    virtual uint8_t kind() const = 0;
+    virtual bool canDebit(long long cents) const = 0;
+};
+
+class SavingsAccount : public Account {
+public:
+    SavingsAccount(uint32_t id, string n, unsigned perms, long long cents) : Account(id, n, perms, cents) {}
+    uint8_t kind() const override { return KIND_SAVINGS; }
+    bool canDebit(long long cents) const override { return balanceCents >= cents; }
+};
+
+class CurrentAccount : public Account {
+public:
+    CurrentAccount(uint32_t id, string n, unsigned perms, long long cents) : Account(id, n, perms, cents) {}
+    uint8_t kind() const override { return KIND_CURRENT; }
+    bool canDebit(long long cents) const override { return balanceCents - cents >= -100000; }   // 1000.00 overdraft
+};
+
+Account* makeAccount(uint8_t kind, uint32_t id, const string& name, unsigned perms, long long cents) {
+    if (kind == KIND_CURRENT) return new CurrentAccount(id, name, perms, cents);
+    return new SavingsAccount(id, name, perms, cents);
+}
+
+// ===== FILE FORMATS =====
+//   Journal : [JournalHeader] then records
+//             record = [crc][accountId][word][timestamp] (+ name bytes for REC_OPEN)
+//             REC_OPEN word = [15][kind:4 at bit 12][permissions:4 at bit 8][nameLength:8]
+//   Snapshot: [SnapshotHeader] then per account
+//             [id u32][kind u8][perms u8][nameLen u16][balance i64][historyCount u32][name][words]
+//             and a trailing crc32 of everything before it
+struct JournalHeader {
+    char magic[4];                      // "AJNL"
+    uint32_t version;
+    uint64_t generation;                // Must match the snapshot to be replayed
+};
+
+struct SnapshotHeader {
+    char magic[4];                      // "ASNP"
+    uint32_t version;
+    uint64_t generation;
+    uint32_t accountCount;
+    uint32_t reserved;
+};
+
+const size_t RECORD_SIZE = 16;
+const uint32_t FORMAT_VERSION = 1;      // Journal and snapshot layout version
+
+bool writeAll(int fd, const char* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(fd, data + written, size - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        written += (size_t)n;
+    }
+    return true;
+}
+
+bool syncFd(int fd) {
+    int rc;
+    do rc = fsync(fd); while (rc != 0 && errno == EINTR);
+    return rc == 0;
+}
+
+// fsync the directory holding 'path' so a rename into it survives a crash
+bool syncParentDir(const string& path) {
+    size_t slash = path.find_last_of('/');
+    string dir = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = open(dir.c_str(), O_RDONLY);
+    bool ok = fd >= 0 && syncFd(fd);
+    if (fd >= 0) close(fd);
+    return ok;
+}
+
+// ===== ACCOUNT STORE =====
+class AccountStore {
+private:
+    string snapshotFile;
+    string journalFile;
+    int journalFd;
+    int snapshotFd;
+    uint64_t generation;
+    int windowMs;                       // Durability window (0 = fsync every append)
+
+    vector<Account*> accounts;
+    // accountId -> index in 'accounts' (open addressing, no STL map)
+    vector<uint32_t> idSlots;
+    static const uint32_t EMPTY = 0xFFFFFFFFu;
+
+    mutex m;
+    condition_variable cv;
+    string pending;                     // Appended, not yet written
+    uint64_t logicalEnd;                // Journal size including pending bytes
+    uint64_t durableEnd;                // Journal bytes known to be fsynced
+    bool flushInProgress;
+    bool journalFailed;                 // A write / fsync failed: store accepts no more writes
+    bool stopping;
+    size_t fsyncCount;
+    size_t replayedCount;
+    thread flusher;
+
+    // ---- id index ----
+    size_t slotFor(uint32_t id) const {
+        size_t mask = idSlots.size() - 1;
+        size_t s = (id * 2654435761u) & mask;
+        while (idSlots[s] != EMPTY && accounts[idSlots[s]]->accountId != id) s = (s + 1) & mask;
+        return s;
+    }
+
+    void indexAccount(uint32_t index) {
+        if ((accounts.size() + 1) * 2 > idSlots.size()) {
+            idSlots.assign(idSlots.empty() ? 64 : idSlots.size() * 2, EMPTY);
+            for (uint32_t i = 0; i < accounts.size(); i++) {
+                if (i != index) idSlots[slotFor(accounts[i]->accountId)] = i;
+            }
+        }
+        idSlots[slotFor(accounts[index]->accountId)] = index;
+    }
+
+    Account* find(uint32_t id) const {
+        if (idSlots.empty()) return nullptr;
+        size_t s = slotFor(id);
+        return idSlots[s] == EMPTY ? nullptr : accounts[idSlots[s]];
+    }
+
+    // ---- journal writing ----
+    // Write + fsync everything pending. Only one flush at a time; the lock is
+    // released during the I/O so appends continue into a fresh buffer.
+    // On failure durableEnd does NOT move and the journal is marked failed:
+    // records that are not on disk are never acknowledged.
+    bool flushLocked(unique_lock<mutex>& lock) {
+        while (flushInProgress) cv.wait(lock);
+        if (journalFailed) return false;
+        if (pending.empty()) return true;
+        flushInProgress = true;
+        string batch;
+        batch.swap(pending);
+        uint64_t batchEnd = logicalEnd;
+        lock.unlock();
+        bool ok = writeAll(journalFd, batch.data(), batch.size()) && syncFd(journalFd);
+        lock.lock();
+        if (ok) {
+            durableEnd = batchEnd;
+            fsyncCount++;
+        } else {
+            cout << "Error: journal write failed, nothing after byte " << durableEnd << " is durable" << endl;
+            journalFailed = true;
+        }
+        flushInProgress = false;
+        cv.notify_all();
+        return ok;
+    }
+
+    // Caller holds m: flush until everything appended so far is on disk
+    bool syncLocked(unique_lock<mutex>& lock) {
+        while (durableEnd < logicalEnd) {
+            if (!flushLocked(lock)) return false;
+        }
+        return !journalFailed;
+    }
+
+    void flusherLoop() {
+        unique_lock<mutex> lock(m);
+        while (!stopping) {
+            cv.wait_for(lock, chrono::milliseconds(windowMs > 0 ? windowMs : 1000));
+            flushLocked(lock);
+        }
+    }
+
+    // Caller holds m; false only when window 0 and the fsync failed
+    bool appendRecord(unique_lock<mutex>& lock, Account* acc, uint32_t word, const string& extra) {
+        char rec[RECORD_SIZE];
+        uint32_t ts = (uint32_t)time(nullptr);
+        memcpy(rec + 4, &acc->accountId, 4);
+        memcpy(rec + 8, &word, 4);
+        memcpy(rec + 12, &ts, 4);
+        string body(rec + 4, 12);
+        body += extra;
+        uint32_t crc = crc32(body.data(), body.size());
+        memcpy(rec, &crc, 4);
+
+        if ((word >> TYPE_SHIFT) != REC_OPEN) acc->journalOffsets.push_back(logicalEnd);
+        pending.append(rec, RECORD_SIZE);
+        pending += extra;
+        logicalEnd += RECORD_SIZE + extra.size();
+
+        if (windowMs == 0) return flushLocked(lock);
+        if (pending.size() >= (1 << 20)) cv.notify_all();        // Big buffer: flush early
+        return true;
+    }
+
+    bool createJournal(uint64_t gen) {
+        string tmp = journalFile + ".tmp";
+        int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            cout << "Error: cannot create " << tmp << endl;
+            return false;
+        }
+        JournalHeader h;
+        memcpy(h.magic, "AJNL", 4);
+        h.version = FORMAT_VERSION;
+        h.generation = gen;
+        bool ok = writeAll(fd, (const char*)&h, sizeof(h)) && syncFd(fd);
+        ok = close(fd) == 0 && ok;
+        if (!ok || rename(tmp.c_str(), journalFile.c_str()) != 0 || !syncParentDir(journalFile)) {
+            cout << "Error: cannot create journal " << journalFile << endl;
+            return false;
+        }
+        if (journalFd >= 0) close(journalFd);
+        journalFd = open(journalFile.c_str(), O_RDWR | O_APPEND);
+        logicalEnd = durableEnd = sizeof(h);
+        if (journalFd < 0) {
+            cout << "Error: cannot open " << journalFile << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // ---- startup ----
+    // false = snapshot exists but is unusable (startup must stop)
+    bool loadSnapshot() {
+        snapshotFd = open(snapshotFile.c_str(), O_RDONLY);
+        if (snapshotFd < 0) return true;      // First start: empty bank, generation 0
+
+        ifstream in(snapshotFile, ios::binary);
+        string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        SnapshotHeader h;
+        uint32_t storedCrc = 0;
+        if (data.size() < sizeof(h) + 4) {
+            cout << "Error: snapshot too small" << endl;
+            return false;
+        }
+        memcpy(&storedCrc, data.data() + data.size() - 4, 4);
+        memcpy(&h, data.data(), sizeof(h));
+        if (memcmp(h.magic, "ASNP", 4) != 0 || crc32(data.data(), data.size() - 4) != storedCrc) {
+            cout << "Error: snapshot is corrupt" << endl;
+            return false;
+        }
+        if (h.version != FORMAT_VERSION) {
+            cout << "Error: snapshot version " << h.version << " is not supported" << endl;
+            return false;
+        }
+        generation = h.generation;
+        size_t pos = sizeof(h), end = data.size() - 4;
+        for (uint32_t a = 0; a < h.accountCount; a++) {
+            if (end - pos < 20) {
+                cout << "Error: snapshot account table is truncated" << endl;
+                return false;
+            }
+            uint32_t id, count;
+            uint8_t kind, perms;
+            uint16_t nameLen;
+            long long balance;
+            memcpy(&id, data.data() + pos, 4);
+            kind = (uint8_t)data[pos + 4];
+            perms = (uint8_t)data[pos + 5];
+            memcpy(&nameLen, data.data() + pos + 6, 2);
+            memcpy(&balance, data.data() + pos + 8, 8);
+            memcpy(&count, data.data() + pos + 16, 4);
+            pos += 20;
+            if (end - pos < nameLen || (end - pos - nameLen) / 4 < count) {
+                cout << "Error: snapshot account " << id << " is truncated" << endl;
+                return false;
+            }
+            Account* acc = makeAccount(kind, id, data.substr(pos, nameLen), perms, balance);
+            pos += nameLen;
+            acc->snapshotOffset = pos;        // History words stay on disk
+            acc->snapshotCount = count;
+            pos += (size_t)count * 4;
+            accounts.push_back(acc);
+            indexAccount((uint32_t)accounts.size() - 1);
+        }
+        return true;
+    }
+
+    // Apply one journal record to the in-memory state
+    void applyRecord(uint32_t id, uint32_t word, const string& name, uint64_t offset) {
+        uint32_t type = word >> TYPE_SHIFT;
+        if (type == REC_OPEN) {
+            Account* acc = makeAccount((uint8_t)((word >> 12) & 0xF), id, name, (word >> 8) & 0xF, 0);
+            accounts.push_back(acc);
+            indexAccount((uint32_t)accounts.size() - 1);
+            return;
+        }
+        Account* acc = find(id);
+        if (!acc) return;
+        long long cents = word & AMOUNT_MASK;
+        acc->balanceCents += type == TX_DEPOSIT ? cents : -cents;
+        acc->journalOffsets.push_back(offset);
+    }
+
+    // Replay the journal tail; false = journal does not belong to the snapshot
+    bool replayJournal() {
+        ifstream in(journalFile, ios::binary);
+        string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        JournalHeader h;
+        replayedCount = 0;
+        if (data.empty()) return createJournal(generation);      // Missing / never written
+        if (data.size() < sizeof(h) || memcmp(data.data(), "AJNL", 4) != 0) {
+            cout << "Error: journal header is corrupt, not touching it" << endl;
+            return false;
+        }
+        memcpy(&h, data.data(), sizeof(h));
+        if (h.version != FORMAT_VERSION) {
+            cout << "Error: journal version " << h.version << " is not supported, not touching it" << endl;
+            return false;
+        }
+        if (h.generation > generation) {
+            // Journal is NEWER than the snapshot: the snapshot it builds on is
+            // missing -> replaying or truncating would both lose data
+            cout << "Error: journal generation " << h.generation << " has no matching snapshot (have "
+                 << generation << ")" << endl;
+            return false;
+        }
+        if (h.generation < generation) {
+            // Older journal: the crash came after the snapshot rename, its
+            // records are already in the snapshot -> start a fresh journal
+            return createJournal(generation);
+        }
+        size_t pos = sizeof(h);
+        while (pos + RECORD_SIZE <= data.size()) {
+            uint32_t crc, id, word;
+            memcpy(&crc, data.data() + pos, 4);
+            memcpy(&id, data.data() + pos + 4, 4);
+            memcpy(&word, data.data() + pos + 8, 4);
+            size_t extra = (word >> TYPE_SHIFT) == REC_OPEN ? (word & 0xFF) : 0;
+            if (pos + RECORD_SIZE + extra > data.size()) break;
+            string body = data.substr(pos + 4, 12 + extra);
+            if (crc32(body.data(), body.size()) != crc) break;     // Torn / corrupt tail
+            applyRecord(id, word, body.substr(12), pos);
+            pos += RECORD_SIZE + extra;
+            replayedCount++;
+        }
+        journalFd = open(journalFile.c_str(), O_RDWR | O_APPEND);
+        if (journalFd < 0) {
+            cout << "Error: cannot open " << journalFile << endl;
+            return false;
+        }
+        if (pos < data.size()) {
+            cout << "Journal: cut " << data.size() - pos << " torn byte(s) at the tail" << endl;
+            if (ftruncate(journalFd, (off_t)pos) != 0) cout << "Warning: could not truncate journal" << endl;
+        }
+        logicalEnd = durableEnd = pos;
+        return true;
+    }
+
+    // Caller holds m and everything appended is on disk
+    vector<uint32_t> historyLocked(Account* acc) {
+        vector<uint32_t> words(acc->snapshotCount);
+        if (acc->snapshotCount > 0 &&
+            pread(snapshotFd, words.data(), acc->snapshotCount * 4, (off_t)acc->snapshotOffset) < 0) {
+            cout << "Error: snapshot read failed" << endl;
+        }
+        for (size_t i = 0; i < acc->journalOffsets.size(); i++) {
+            uint32_t word = 0;
+            if (pread(journalFd, &word, 4, (off_t)(acc->journalOffsets[i] + 8)) < 0) cout << "Error: journal read failed" << endl;
+            words.push_back(word);
+        }
+        return words;
+    }
+
+public:
+    AccountStore(string snapshot, string journal, int durabilityWindowMs)
+        : snapshotFile(snapshot), journalFile(journal), journalFd(-1), snapshotFd(-1), generation(0),
+          windowMs(durabilityWindowMs), logicalEnd(0), durableEnd(0), flushInProgress(false),
+          journalFailed(false), stopping(false), fsyncCount(0), replayedCount(0) {}
+
+    ~AccountStore() {
+        if (flusher.joinable()) {
+            {
+                lock_guard<mutex> lock(m);
+                stopping = true;
+            }
+            cv.notify_all();
+            flusher.join();
+        }
+        unique_lock<mutex> lock(m);
+        flushLocked(lock);
+        if (journalFd >= 0) close(journalFd);
+        if (snapshotFd >= 0) close(snapshotFd);
+        for (size_t i = 0; i < accounts.size(); i++) delete accounts[i];
+    }
+
+    AccountStore(const AccountStore&) = delete;
+    AccountStore& operator=(const AccountStore&) = delete;
+
+    // Snapshot + journal tail, then start the background flusher.
+    // false = files are inconsistent: nothing is modified and the store stays closed
+    bool load() {
+        if (!loadSnapshot() || !replayJournal()) {
+            cout << "Error: refusing to start, repair or restore the files first" << endl;
+            return false;
+        }
+        if (windowMs > 0) flusher = thread(&AccountStore::flusherLoop, this);
+        return true;
+    }
+
+    size_t replayedRecords() const { return replayedCount; }
+
+    bool openAccount(uint32_t id, const string& name, uint8_t kind, unsigned perms) {
+        unique_lock<mutex> lock(m);
+        if (journalFd < 0 || journalFailed || find(id) || name.size() > 255) {
+            cout << "Error: cannot open account " << id << endl;
+            return false;
+        }
+        Account* acc = makeAccount(kind, id, name, perms, 0);
+        accounts.push_back(acc);
+        indexAccount((uint32_t)accounts.size() - 1);
+        uint32_t word = (REC_OPEN << TYPE_SHIFT) | ((uint32_t)kind << 12) | ((perms & 0xF) << 8) | (uint32_t)name.size();
+        return appendRecord(lock, acc, word, name);
+    }
+
+    bool deposit(uint32_t id, long long cents) {
+        unique_lock<mutex> lock(m);
+        Account* acc = find(id);
+        if (journalFd < 0 || journalFailed || !acc || !(acc->permissions & CAN_DEPOSIT) || cents <= 0 ||
+            cents > (long long)AMOUNT_MASK) return false;
+        acc->balanceCents += cents;
+        return appendRecord(lock, acc, encodeTx(TX_DEPOSIT, (uint32_t)cents), "");
+    }
+
+    bool withdraw(uint32_t id, long long cents) {
+        unique_lock<mutex> lock(m);
+        Account* acc = find(id);
+        if (journalFd < 0 || journalFailed || !acc || !(acc->permissions & CAN_WITHDRAW) || cents <= 0 ||
+            cents > (long long)AMOUNT_MASK) return false;
+        if (!acc->canDebit(cents)) return false;
+        acc->balanceCents -= cents;
+        return appendRecord(lock, acc, encodeTx(TX_WITHDRAWAL, (uint32_t)cents), "");
+    }
+
+    // Block until everything appended so far is on disk (false = it never will be)
+    bool sync() {
+        unique_lock<mutex> lock(m);
+        return syncLocked(lock);
+    }
+
+    // One account's history through the offset index (no journal scan)
+    vector<uint32_t> history(uint32_t id) {
+        unique_lock<mutex> lock(m);
+        if (!syncLocked(lock)) return vector<uint32_t>();       // Offsets must point at written bytes
+        Account* acc = find(id);
+        return acc ? historyLocked(acc) : vector<uint32_t>();
+    }
+
+    // Fold snapshot + journal into a new snapshot, then an empty journal.
+    // Appends are blocked for the whole compaction: balances and histories
+    // come from the same instant, so no record can slip between them.
+    // false = compaction did not happen (or the new journal could not be
+    // created, which also stops further writes until the store is reloaded)
+    bool compact() {
+        unique_lock<mutex> lock(m);
+        if (journalFd < 0) return false;
+        // flushLocked drops the lock during I/O; loop until nothing is pending
+        // with the lock held, and keep holding it from here on
+        if (!syncLocked(lock)) return false;
+        vector<vector<uint32_t>> histories;
+        histories.reserve(accounts.size());
+        for (size_t i = 0; i < accounts.size(); i++) histories.push_back(historyLocked(accounts[i]));
+
+        string data;
+        SnapshotHeader h;
+        memcpy(h.magic, "ASNP", 4);
+        h.version = FORMAT_VERSION;
+        h.generation = generation + 1;
+        h.accountCount = (uint32_t)accounts.size();
+        h.reserved = 0;
+        data.append((const char*)&h, sizeof(h));
+        vector<uint64_t> offsets(accounts.size());
+        for (size_t i = 0; i < accounts.size(); i++) {
+            Account* acc = accounts[i];
+            char fixed[20];
+            uint16_t nameLen = (uint16_t)acc->name.size();
+            uint32_t count = (uint32_t)histories[i].size();
+            memcpy(fixed, &acc->accountId, 4);
+            fixed[4] = (char)acc->kind();
+            fixed[5] = (char)acc->permissions;
+            memcpy(fixed + 6, &nameLen, 2);
+            memcpy(fixed + 8, &acc->balanceCents, 8);
+            memcpy(fixed + 16, &count, 4);
+            data.append(fixed, 20);
+            data += acc->name;
+            offsets[i] = data.size();
+            data.append((const char*)histories[i].data(), count * 4);
+        }
+        uint32_t crc = crc32(data.data(), data.size());
+        data.append((const char*)&crc, 4);
+
+        string tmp = snapshotFile + ".tmp";
+        int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool written = fd >= 0 && writeAll(fd, data.data(), data.size()) && syncFd(fd);   // Durable BEFORE rename
+        if (fd >= 0) written = close(fd) == 0 && written;
+        if (!written) {
+            cout << "Error: snapshot write failed, journal kept" << endl;
+            return false;
+        }
+        if (rename(tmp.c_str(), snapshotFile.c_str()) != 0) {
+            cout << "Error: snapshot rename failed, journal kept" << endl;
+            return false;
+        }
+        // The new snapshot is in place (its generation makes the old journal stale)
+        // even if the directory sync below fails, so memory must follow it now
+        bool renamed = syncParentDir(snapshotFile);
+        generation++;
+        if (snapshotFd >= 0) close(snapshotFd);
+        snapshotFd = open(snapshotFile.c_str(), O_RDONLY);
+        for (size_t i = 0; i < accounts.size(); i++) {
+            accounts[i]->snapshotOffset = offsets[i];
+            accounts[i]->snapshotCount = (uint32_t)histories[i].size();
+            accounts[i]->journalOffsets.clear();
+        }
+        // Crash before this: the old journal is ignored on startup
+        if (!renamed || snapshotFd < 0 || !createJournal(generation)) {
+            cout << "Error: compaction could not finish, reload the store before writing again" << endl;
+            journalFailed = true;
+            return false;
+        }
+        return true;
+    }
+
+    // Test helper: half a record at the end of the journal, like a crash mid-write
+    void simulateTornWrite() {
+        if (!sync()) return;
+        char half[RECORD_SIZE / 2] = {1, 2, 3, 4, 5, 6, 7, 8};
+        lock_guard<mutex> lock(m);
+        writeAll(journalFd, half, sizeof(half));
+        fsync(journalFd);
+    }
+
+    long long balance(uint32_t id) {
+        lock_guard<mutex> lock(m);
+        Account* acc = find(id);
+        return acc ? acc->balanceCents : 0;
+    }
+
+    long long totalBalance() {
+        lock_guard<mutex> lock(m);
+        long long total = 0;
+        for (size_t i = 0; i < accounts.size(); i++) total += accounts[i]->balanceCents;
+        return total;
+    }
+
+    size_t accountCount() const { return accounts.size(); }
+    size_t fsyncs() const { return fsyncCount; }
+    uint64_t journalBytes() const { return logicalEnd; }
+    uint64_t snapshotGeneration() const { return generation; }
+};
+
+// Static constant definition (needed because vector::assign takes it by reference)
+const uint32_t AccountStore::EMPTY;
+
+// ===== BASELINE: spec-style text file, rewritten on every save =====
+void saveWholeBankAsText(const string& path, const vector<long long>& balances, const vector<vector<double>>& history) {
+    ofstream out(path);
+    for (size_t i = 0; i < balances.size(); i++) {
+        out << "ACCOUNT Savings\n" << 1000 + i << " acct" << i << " " << balances[i] / 100.0 << " 7\nTRANSACTIONS\n";
+        for (size_t k = 0; k < history[i].size(); k++) out << history[i][k] << "\n";
+        out << "\n";
+    }
+    out.flush();
+    out.close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    initCrcTable();
+    const string snapshot = "bank.snapshot";
+    const string journal = "bank.journal";
+    remove(snapshot.c_str());
+    remove(journal.c_str());
+
+    const uint32_t ACCOUNTS = 2000;
+    const size_t OPS = 200000;
+    long long expectedTotal = 0;
+    vector<uint32_t> aliHistory;
+
+    cout << "===== FIRST RUN: open accounts, " << OPS << " transactions, 5 ms durability window =====" << endl;
+    {
+        AccountStore bank(snapshot, journal, 5);
+        bank.load();
+        for (uint32_t i = 0; i < ACCOUNTS; i++) {
+            bank.openAccount(1000 + i, "acct" + to_string(i), i % 5 == 0 ? KIND_CURRENT : KIND_SAVINGS,
+                             CAN_WITHDRAW | CAN_DEPOSIT | CAN_TRANSFER);
+        }
+        unsigned seed = 5;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < OPS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            uint32_t id = 1000 + (seed >> 8) % ACCOUNTS;
+            long long cents = 100 + (seed >> 4) % 50000;
+            if ((seed >> 20) % 3 == 0) bank.withdraw(id, cents);
+            else bank.deposit(id, cents);
+        }
+        bank.sync();
+        double ms = millisecondsSince(start);
+        cout << "Journal append : " << ms * 1000 / OPS << " us per transaction, " << bank.fsyncs()
+             << " fsyncs, journal " << bank.journalBytes() / 1024 << " KB" << endl;
+        expectedTotal = bank.totalBalance();
+        aliHistory = bank.history(1000);
+        cout << "Account 1000   : " << aliHistory.size() << " transactions read through the offset index" << endl;
+
+        bank.compact();
+        cout << "Compacted into snapshot generation " << bank.snapshotGeneration() << ", journal now "
+             << bank.journalBytes() << " bytes" << endl;
+    }
+    {
+        // Window 0: fsync on every append (smaller sample, each one waits for the disk)
+        remove("sync.snapshot");
+        remove("sync.journal");
+        AccountStore strict("sync.snapshot", "sync.journal", 0);
+        strict.load();
+        strict.openAccount(1, "strict", KIND_SAVINGS, CAN_DEPOSIT);
+        const size_t SMALL = 200;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < SMALL; i++) strict.deposit(1, 100);
+        cout << "Window 0 (fsync per transaction): " << millisecondsSince(start) * 1000 / SMALL << " us per transaction" << endl;
+        remove("sync.snapshot");
+        remove("sync.journal");
+    }
+    {
+        // Spec baseline: one deposit -> rewrite the whole bank text file
+        vector<long long> balances(ACCOUNTS, 100000);
+        vector<vector<double>> history(ACCOUNTS, vector<double>(OPS / ACCOUNTS, 123.45));
+        const size_t SAVES = 20;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < SAVES; i++) {
+            balances[i] += 100;
+            history[i].push_back(1.0);
+            saveWholeBankAsText("bank.txt", balances, history);
+        }
+        cout << "Text rewrite   : " << millisecondsSince(start) * 1000 / SAVES << " us per transaction (whole file each time)" << endl;
+        remove("bank.txt");
+    }
+
+    cout << "\n===== SECOND RUN: more transactions after the snapshot, then a torn write =====" << endl;
+    {
+        AccountStore bank(snapshot, journal, 5);
+        bank.load();
+        cout << "Startup replayed " << bank.replayedRecords() << " journal records (snapshot holds the rest)" << endl;
+        for (size_t i = 0; i < 1000; i++) bank.deposit(1000 + (uint32_t)(i % 10), 250);
+        expectedTotal += 1000 * 250;
+        bank.sync();
+        bank.simulateTornWrite();
+    }
+
+    cout << "\n===== THIRD RUN: recovery =====" << endl;
+    {
+        AccountStore bank(snapshot, journal, 5);
+        auto start = chrono::steady_clock::now();
+        bank.load();
+        cout << "Startup: " << millisecondsSince(start) << " ms, replayed " << bank.replayedRecords() << " tail records, "
+             << bank.accountCount() << " accounts" << endl;
+        cout << "Total balance matches : " << (bank.totalBalance() == expectedTotal ? "YES" : "NO") << endl;
+        vector<uint32_t> h = bank.history(1000);
+        bool prefix = h.size() == aliHistory.size() + 100 && equal(aliHistory.begin(), aliHistory.end(), h.begin());
+        cout << "Account 1000 history  : " << h.size() << " entries, snapshot part unchanged: " << (prefix ? "YES" : "NO") << endl;
+    }
+
+    cout << "\n===== FOURTH RUN: corrupt snapshot =====" << endl;
+    {
+        // Flip one byte in the snapshot: startup must refuse, not drop the journal
+        uint64_t journalSize = 0;
+        {
+            fstream f(snapshot, ios::in | ios::out | ios::binary);
+            f.seekp(sizeof(SnapshotHeader) + 8);
+            f.put('\x7F');
+            ifstream j(journal, ios::binary | ios::ate);
+            journalSize = (uint64_t)j.tellg();
+        }
+        AccountStore bank(snapshot, journal, 5);
+        bool started = bank.load();
+        bool refused = !bank.deposit(1000, 100);
+        ifstream j(journal, ios::binary | ios::ate);
+        cout << "Started: " << (started ? "YES" : "NO") << ", deposits refused: " << (refused ? "YES" : "NO")
+             << ", journal untouched: " << ((uint64_t)j.tellg() == journalSize ? "YES" : "NO") << endl;
+    }
+    remove(snapshot.c_str());
+    remove(journal.c_str());
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Append-Only Journal
+       - One fixed 16-byte record per transaction (+ name bytes for REC_OPEN)
+       - Cost per transaction is independent of the bank size
+       - Old bytes are never rewritten -> a crash cannot damage them
+
+    2. Durability Window (Batched fsync)
+       - Records go to a memory buffer; the flusher thread writes + fsyncs it
+         every N ms (or when it grows past 1 MB)
+       - Thousands of transactions share one fsync
+       - Trade-off: a crash loses at most the last N ms of acknowledged work;
+         window 0 gives fsync-per-transaction durability at fsync speed
+       - A failed write / fsync never moves durableEnd: sync() returns false,
+         window-0 writes return false, and the store refuses further writes
+
+    3. Per-Account Offset Index
+       - Each account remembers where its records are:
+         snapshot (offset + count) and journal (one offset per record)
+       - history(id) = one pread for the snapshot part + one per journal record
+
+    4. Compaction
+       - Write every account (balance + history words) into snapshot.tmp
+       - fsync, rename (atomic), then an EMPTY journal with generation + 1
+       - Crash between the two: journal generation is older than the
+         snapshot -> ignored on startup (its records are in the snapshot)
+       - Every fsync / rename (and the directory fsync after it) is checked;
+         compact() returns false if any step fails
+
+    5. Startup = Snapshot + Tail Replay
+       - Snapshot: balances directly, history stays on disk
+       - Replay only the records written since the last compaction
+       - Corrupt snapshot, unknown format version, bad journal header or a
+         journal newer than the snapshot -> load() returns false and leaves
+         both files as they are
+
+    6. Torn Writes
+       - CRC32 over each record; the first bad record ends the replay
+       - ftruncate cuts the garbage so new appends start at a clean offset
+*/
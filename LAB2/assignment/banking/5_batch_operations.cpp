@@ -0,0 +1,379 @@
+/*
+    5) BATCHED DEPOSIT / WITHDRAW (Nightly Settlement)
+
+    Explanation:
+    - One-at-a-time API: for EVERY operation
+          find account -> virtual deposit()/withdraw() -> (permissions & 1 or 2)
+          -> history.push_back()
+      -> a virtual call, a few unpredictable branches and a possible vector
+         reallocation per operation, and accounts are visited in random order
+    - Batch API: applyBatch(ops, n) for a whole span of (accountId, op, amount)
+          1) resolve every accountId to an index        (hash index, no map)
+          2) permission check for ALL ops at once       (branch-free loop over arrays)
+          3) group ops by account                       (counting sort, keeps order)
+          4) per account: one virtual call to get its debit limit, apply its
+             ops in order, ONE history append for all of them
+          5) result: status bitmap, bit i = 1 if op i was applied
+    - Grouping keeps each account's ops in their original order, so the final
+      balances, histories and statuses equal the one-at-a-time results
+    - Step 4 is split across threads by account range (groups are independent)
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+using namespace std;
+
+// ===== PACKED HISTORY WORD (2_packed_transaction_log.cpp) =====
+const uint32_t TYPE_SHIFT = 28;
+const uint32_t AMOUNT_MASK = 0x0FFFFFFF;
+const uint32_t TX_DEPOSIT = 1;
+const uint32_t TX_WITHDRAWAL = 2;
+
+// ===== PERMISSIONS =====
+const unsigned CAN_WITHDRAW = 1;
+const unsigned CAN_DEPOSIT = 2;
+const unsigned CAN_TRANSFER = 4;
+
+// ===== OPERATION RECORD =====
+const uint8_t OP_DEPOSIT = 1;
+const uint8_t OP_WITHDRAW = 2;
+
+struct Operation {
+    uint32_t accountId;
+    uint32_t amountCents;
+    uint8_t op;
+};
+
+// ===== ACCOUNTS =====
+class Account {
+protected:
+    uint32_t accountId;
+    string name;
+    unsigned permissions;
+
+public:
+    long long balanceCents;
+    vector<uint32_t> history;
+
+    Account(uint32_t id, string n, unsigned perms, long long cents)
+        : accountId(id), name(n), permissions(perms), balanceCents(cents) {}
+
+    virtual ~Account() {}
+
+    // Lowest balance this account may reach
+    virtual long long minimumBalance() const = 0;
+
+    // One-at-a-time API (baseline)
+    virtual bool deposit(uint32_t cents) {
+        if (!(permissions & CAN_DEPOSIT) || cents == 0 || cents > AMOUNT_MASK) return false;
+        balanceCents += cents;
+        history.push_back((TX_DEPOSIT << TYPE_SHIFT) | cents);
+        return true;
+    }
+
+    virtual bool withdraw(uint32_t cents) {
+        if (!(permissions & CAN_WITHDRAW) || cents == 0 || cents > AMOUNT_MASK) return false;
+        if (balanceCents - cents < minimumBalance()) return false;
+        balanceCents -= cents;
+        history.push_back((TX_WITHDRAWAL << TYPE_SHIFT) | cents);
+        return true;
+    }
+
+    uint32_t getId() const { return accountId; }
+    unsigned getPermissions() const { return permissions; }
+};
+
+class SavingsAccount : public Account {
+public:
+    SavingsAccount(uint32_t id, string n, unsigned perms, long long cents) : Account(id, n, perms, cents) {}
+    long long minimumBalance() const override { return 0; }
+};
+
+class CurrentAccount : public Account {
+private:
+    long long overdraftCents;
+
+public:
+    CurrentAccount(uint32_t id, string n, unsigned perms, long long cents, long long overdraft)
+        : Account(id, n, perms, cents), overdraftCents(overdraft) {}
+    long long minimumBalance() const override { return -overdraftCents; }
+};
+
+// ===== BANK =====
+class Bank {
+private:
+    vector<Account*> accounts;
+    // accountId -> index in 'accounts' (open addressing, no STL map)
+    vector<uint32_t> idSlots;
+    vector<uint32_t> slotIds;
+    static const uint32_t EMPTY = 0xFFFFFFFFu;
+
+    // Per-account permissions copied into a flat array for the bulk check
+    vector<uint8_t> permissionTable;
+
+    size_t slotFor(uint32_t id) const {
+        size_t mask = idSlots.size() - 1;
+        size_t s = (id * 2654435761u) & mask;
+        while (idSlots[s] != EMPTY && slotIds[s] != id) s = (s + 1) & mask;
+        return s;
+    }
+
+    void rebuildIndex() {
+        size_t capacity = 64;
+        while (capacity < accounts.size() * 2) capacity <<= 1;
+        idSlots.assign(capacity, EMPTY);
+        slotIds.assign(capacity, 0);
+        for (uint32_t i = 0; i < accounts.size(); i++) {
+            size_t s = slotFor(accounts[i]->getId());
+            idSlots[s] = i;
+            slotIds[s] = accounts[i]->getId();
+        }
+    }
+
+public:
+    ~Bank() {
+        for (size_t i = 0; i < accounts.size(); i++) delete accounts[i];
+    }
+
+    // Accounts are added before any batch runs; the index is rebuilt on growth
+    void addAccount(Account* acc) {
+        accounts.push_back(acc);
+        permissionTable.push_back((uint8_t)acc->getPermissions());
+        if (accounts.size() * 2 > idSlots.size()) rebuildIndex();
+        else {
+            size_t s = slotFor(acc->getId());
+            idSlots[s] = (uint32_t)accounts.size() - 1;
+            slotIds[s] = acc->getId();
+        }
+    }
+
+    uint32_t indexOf(uint32_t id) const {
+        return idSlots[slotFor(id)];
+    }
+
+    Account* at(size_t i) const { return accounts[i]; }
+    size_t size() const { return accounts.size(); }
+
+    // ----- one-at-a-time baseline -----
+    bool apply(const Operation& o) {
+        uint32_t index = indexOf(o.accountId);
+        if (index == EMPTY) return false;
+        return o.op == OP_DEPOSIT ? accounts[index]->deposit(o.amountCents) : accounts[index]->withdraw(o.amountCents);
+    }
+
+    // ----- batch API -----
+    // status[i / 64] bit (i % 64) = 1 if ops[i] was applied
+    vector<uint64_t> applyBatch(const Operation* ops, size_t n, unsigned threads) {
+        // 1) Resolve ids
+        vector<uint32_t> index(n);
+        for (size_t i = 0; i < n; i++) index[i] = indexOf(ops[i].accountId);
+
+        // 2) Bulk validity: known account, permission bit for the op, amount in range.
+        //    OP_DEPOSIT (1) needs CAN_DEPOSIT (2), OP_WITHDRAW (2) needs CAN_WITHDRAW (1):
+        //    required bit = 3 - op. No branches, so the compiler can vectorize it.
+        vector<uint8_t> ok(n);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t idx = index[i];
+            unsigned perms = idx != EMPTY ? permissionTable[idx] : 0;
+            unsigned required = 3u - ops[i].op;
+            uint32_t amount = ops[i].amountCents;
+            ok[i] = (uint8_t)(((perms & required) != 0) & (amount - 1 < AMOUNT_MASK) &
+                              ((ops[i].op == OP_DEPOSIT) | (ops[i].op == OP_WITHDRAW)));
+        }
+
+        // 3) Group by account: counting sort of op positions (stable)
+        vector<uint32_t> start(accounts.size() + 1, 0);
+        for (size_t i = 0; i < n; i++) {
+            if (ok[i]) start[index[i] + 1]++;
+        }
+        for (size_t a = 0; a < accounts.size(); a++) start[a + 1] += start[a];
+        vector<uint32_t> order(start[accounts.size()]);
+        {
+            vector<uint32_t> fill(start.begin(), start.end() - 1);
+            for (size_t i = 0; i < n; i++) {
+                if (ok[i]) order[fill[index[i]]++] = (uint32_t)i;
+            }
+        }
+
+        // 4) Apply per account, threads own disjoint account ranges
+        //    (ranges balanced by number of ops, not number of accounts)
+        vector<uint8_t> applied(n, 0);
+        auto work = [&](size_t firstAccount, size_t lastAccount) {
+            vector<uint32_t> words;
+            for (size_t a = firstAccount; a < lastAccount; a++) {
+                uint32_t begin = start[a], end = start[a + 1];
+                if (begin == end) continue;
+                Account* acc = accounts[a];
+                long long balance = acc->balanceCents;
+                long long floor = acc->minimumBalance();     // One virtual call per account
+                words.clear();
+                for (uint32_t k = begin; k < end; k++) {
+                    const Operation& o = ops[order[k]];
+                    if (o.op == OP_DEPOSIT) {
+                        balance += o.amountCents;
+                    } else {
+                        if (balance - o.amountCents < floor) continue;
+                        balance -= o.amountCents;
+                    }
+                    applied[order[k]] = 1;
+                    words.push_back(((uint32_t)o.op << TYPE_SHIFT) | o.amountCents);
+                }
+                acc->balanceCents = balance;
+                acc->history.insert(acc->history.end(), words.begin(), words.end());   // One append
+            }
+        };
+        if (threads <= 1) {
+            work(0, accounts.size());
+        } else {
+            vector<thread> workers;
+            size_t total = order.size(), a = 0;
+            for (unsigned t = 0; t < threads && a < accounts.size(); t++) {
+                size_t target = total * (t + 1) / threads, b = a;
+                while (b < accounts.size() && (start[b] < target || b == a)) b++;
+                if (t == threads - 1) b = accounts.size();
+                workers.push_back(thread(work, a, b));
+                a = b;
+            }
+            if (a < accounts.size()) work(a, accounts.size());
+            for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+        }
+
+        // 5) Pack the status bytes into a bitmap (64 ops per word)
+        vector<uint64_t> status((n + 63) / 64, 0);
+        for (size_t i = 0; i < n; i++) status[i >> 6] |= (uint64_t)applied[i] << (i & 63);
+        return status;
+    }
+};
+
+// Static constant definition (needed because vector::assign takes it by reference)
+const uint32_t Bank::EMPTY;
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void buildBank(Bank& bank, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        unsigned perms = CAN_DEPOSIT | CAN_TRANSFER | (i % 7 == 0 ? 0 : CAN_WITHDRAW);   // Some deposit-only
+        if (i % 4 == 0) bank.addAccount(new CurrentAccount(100000 + i, "acct" + to_string(i), perms, 50000, 100000));
+        else bank.addAccount(new SavingsAccount(100000 + i, "acct" + to_string(i), perms, 50000));
+    }
+}
+
+int main() {
+    cout << "===== SMALL BATCH =====" << endl;
+    {
+        Bank bank;
+        bank.addAccount(new SavingsAccount(1001, "Ali", CAN_DEPOSIT | CAN_WITHDRAW, 10000));
+        bank.addAccount(new CurrentAccount(1002, "Sara", CAN_DEPOSIT | CAN_WITHDRAW, 0, 50000));
+        bank.addAccount(new SavingsAccount(1003, "Omar", CAN_DEPOSIT, 0));
+        Operation ops[] = {
+            {1001, 5000, OP_DEPOSIT},  {1002, 30000, OP_WITHDRAW}, {1003, 2000, OP_WITHDRAW},
+            {1001, 20000, OP_WITHDRAW}, {1002, 30000, OP_WITHDRAW}, {9999, 100, OP_DEPOSIT},
+            {1001, 15000, OP_WITHDRAW}, {1003, 0, OP_DEPOSIT},
+        };
+        const char* why[] = {"", "", "no withdraw permission", "insufficient funds", "overdraft limit",
+                             "unknown account", "", "zero amount"};
+        size_t n = sizeof(ops) / sizeof(ops[0]);
+        vector<uint64_t> status = bank.applyBatch(ops, n, 1);
+        for (size_t i = 0; i < n; i++) {
+            bool done = (status[0] >> i) & 1;
+            cout << "  op " << i << ": " << (ops[i].op == OP_DEPOSIT ? "deposit  " : "withdraw ") << ops[i].accountId
+                 << " " << ops[i].amountCents << " -> " << (done ? "OK" : "FAILED") << (done ? "" : " (") << why[i]
+                 << (done ? "" : ")") << endl;
+        }
+        cout << "Status bitmap: 0x" << hex << status[0] << dec << endl;
+        for (size_t a = 0; a < bank.size(); a++) {
+            cout << "  account " << bank.at(a)->getId() << ": balance " << bank.at(a)->balanceCents
+                 << ", " << bank.at(a)->history.size() << " history words" << endl;
+        }
+    }
+
+    const uint32_t ACCOUNTS = 200000;
+    const size_t N = 10000000;
+    cout << "\n===== SETTLEMENT: " << N << " operations over " << ACCOUNTS << " accounts =====" << endl;
+    vector<Operation> ops(N);
+    unsigned seed = 17;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        ops[i].accountId = 100000 + (seed >> 8) % (ACCOUNTS + 100);          // A few unknown ids
+        seed = seed * 1103515245u + 12345u;
+        ops[i].op = (seed >> 20) % 2 ? OP_DEPOSIT : OP_WITHDRAW;
+        ops[i].amountCents = (seed >> 4) % 40000;                           // Includes some zeros
+    }
+
+    Bank single;
+    buildBank(single, ACCOUNTS);
+    vector<uint64_t> expected((N + 63) / 64, 0);
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) expected[i >> 6] |= (uint64_t)single.apply(ops[i]) << (i & 63);
+    double singleMs = millisecondsSince(start);
+
+    Bank batched;
+    buildBank(batched, ACCOUNTS);
+    start = chrono::steady_clock::now();
+    vector<uint64_t> status = batched.applyBatch(ops.data(), N, 1);
+    double batchMs = millisecondsSince(start);
+
+    unsigned threads = thread::hardware_concurrency();
+    if (threads < 2) threads = 2;
+    Bank parallel;
+    buildBank(parallel, ACCOUNTS);
+    start = chrono::steady_clock::now();
+    vector<uint64_t> parallelStatus = parallel.applyBatch(ops.data(), N, threads);
+    double parallelMs = millisecondsSince(start);
+
+    bool same = status == expected && parallelStatus == expected;
+    for (size_t a = 0; a < ACCOUNTS && same; a++) {
+        same = single.at(a)->balanceCents == batched.at(a)->balanceCents &&
+               single.at(a)->history == batched.at(a)->history &&
+               single.at(a)->history == parallel.at(a)->history;
+    }
+    size_t appliedCount = 0;
+    for (size_t w = 0; w < status.size(); w++) appliedCount += (size_t)__builtin_popcountll(status[w]);
+
+    cout << "Applied " << appliedCount << " of " << N << " operations" << endl;
+    cout << "One at a time       : " << singleMs << " ms (" << (long long)(N / (singleMs / 1000)) << " ops/s)" << endl;
+    cout << "Batch, 1 thread     : " << batchMs << " ms (" << (long long)(N / (batchMs / 1000)) << " ops/s)" << endl;
+    cout << "Batch, " << threads << " threads    : " << parallelMs << " ms (" << (long long)(N / (parallelMs / 1000)) << " ops/s)" << endl;
+    cout << "Same balances, histories and statuses: " << (same ? "YES" : "NO") << endl;
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Batch Instead of Calls
+       - One call for millions of operations: the per-call overhead
+         (virtual dispatch, lookups, checks) is paid in bulk
+
+    2. Branch-Free Permission Check
+       - Deposit needs bit 2, withdraw needs bit 1 -> required = 3 - op
+       - ok = (perms & required) != 0, combined with & (not &&): no branches
+       - Unsigned trick: amount - 1 < MASK  <=>  1 <= amount <= MASK
+
+    3. Counting Sort Grouping
+       - Count ops per account, prefix-sum -> start of each account's group
+       - Place op positions in original order -> stable grouping in O(n + accounts)
+
+    4. Same Results as One-at-a-Time
+       - Ops on different accounts do not affect each other
+       - Each account sees its own ops in the original order
+
+    5. One Virtual Call and One Append per Account
+       - minimumBalance() once per group, then plain integer compares
+       - history.insert() once per group: one possible reallocation, not many
+
+    6. Status Bitmap
+       - 1 bit per operation: 100M operations -> 12.5 MB of status
+       - Popcount gives the number of applied operations
+
+    7. Parallel Apply
+       - Account groups are disjoint -> threads never touch the same account
+       - Ranges are balanced by operation count
+*/
@@ -0,0 +1,424 @@
+/*
+    7) SHARDED ACCOUNT REGISTRY (accountId -> Account*)
+
+    Explanation:
+    - Banking spec: accounts live in vector<Account*>, STL map / set are NOT allowed
+      -> "find account by id" for deposit / withdraw / transfer is a linear scan:
+         O(n) pointer dereferences per operation (10M accounts -> 10M per lookup)
+    - Registry: an in-house open-addressing hash table kept NEXT to the vector
+      (the vector still owns the accounts; the registry only points into it)
+          hash(id) -> top bits pick one of 64 shards
+                   -> next bits pick the starting slot inside that shard
+                   -> linear probing until the id or an empty slot is found
+    - Each shard has its own shared_mutex (reader-writer lock):
+      -> lookups take a SHARED lock: any number of readers run together
+      -> registering an account takes an EXCLUSIVE lock on ONE shard only;
+         the other 63 shards keep serving lookups
+      -> a growing shard rehashes only itself (1/64 of the table)
+    - Load factor <= 1/2 -> a lookup probes ~1.5 slots on average: O(1)
+      at 10K or at 10M accounts
+    - The registry guards the id -> pointer mapping, not the account's balance
+      (balance locking is 1_concurrent_ledger.cpp's job)
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// ===== PERMISSION FLAGS =====
+const unsigned CAN_WITHDRAW = 1;
+const unsigned CAN_DEPOSIT = 2;
+const unsigned CAN_TRANSFER = 4;
+
+// ===== ACCOUNTS =====
+class Account {
+protected:
+    uint32_t accountId;
+    string name;
+    unsigned permissions;
+    long long balanceCents;
+
+public:
+    Account(uint32_t id, string n, unsigned perms, long long cents)
+        : accountId(id), name(n), permissions(perms), balanceCents(cents) {}
+
+    virtual ~Account() {}
+
+    virtual long long minimumBalance() const = 0;
+
+    bool deposit(long long cents) {
+        if (!(permissions & CAN_DEPOSIT) || cents <= 0) return false;
+        balanceCents += cents;
+        return true;
+    }
+
+    bool withdraw(long long cents) {
+        if (!(permissions & CAN_WITHDRAW) || cents <= 0) return false;
+        if (balanceCents - cents < minimumBalance()) return false;
+        balanceCents -= cents;
+        return true;
+    }
+
+    uint32_t getId() const { return accountId; }
+    long long getBalance() const { return balanceCents; }
+    unsigned getPermissions() const { return permissions; }
+};
+
+class SavingsAccount : public Account {
+public:
+    SavingsAccount(uint32_t id, string n, unsigned perms, long long cents) : Account(id, n, perms, cents) {}
+    long long minimumBalance() const override { return 0; }
+};
+
+class CurrentAccount : public Account {
+private:
+    long long overdraftCents;
+
+public:
+    CurrentAccount(uint32_t id, string n, unsigned perms, long long cents, long long overdraft)
+        : Account(id, n, perms, cents), overdraftCents(overdraft) {}
+    long long minimumBalance() const override { return -overdraftCents; }
+};
+
+// ===== SHARDED REGISTRY =====
+class AccountRegistry {
+private:
+    static const unsigned SHARD_BITS = 6;
+    static const unsigned SHARDS = 1u << SHARD_BITS;
+
+    // One shard per cache line start: the lock of one shard never shares a
+    // line with the lock of another
+    struct alignas(64) Shard {
+        mutable shared_mutex lock;
+        vector<uint32_t> ids;           // Key per slot
+        vector<Account*> slots;         // nullptr = empty slot
+        unsigned bits;                  // log2(capacity)
+        size_t count;
+    };
+
+    Shard shards[SHARDS];
+
+    static uint64_t hashId(uint32_t id) {
+        return (uint64_t)id * 0x9E3779B97F4A7C15ull;    // Fibonacci hashing
+    }
+
+    // Slot index from the bits just below the shard bits
+    static size_t startSlot(uint64_t h, unsigned bits) {
+        return (size_t)((h << SHARD_BITS) >> (64 - bits));
+    }
+
+    // Lock must be held by the caller
+    static size_t probe(const Shard& s, uint32_t id, uint64_t h) {
+        size_t mask = s.slots.size() - 1;
+        size_t i = startSlot(h, s.bits);
+        while (s.slots[i] != nullptr && s.ids[i] != id) i = (i + 1) & mask;
+        return i;
+    }
+
+    // Exclusive lock held: double the shard and re-place its entries
+    static void grow(Shard& s) {
+        vector<uint32_t> oldIds;
+        vector<Account*> oldSlots;
+        oldIds.swap(s.ids);
+        oldSlots.swap(s.slots);
+        s.bits++;
+        s.ids.assign((size_t)1 << s.bits, 0);
+        s.slots.assign((size_t)1 << s.bits, nullptr);
+        for (size_t i = 0; i < oldSlots.size(); i++) {
+            if (oldSlots[i] == nullptr) continue;
+            size_t j = probe(s, oldIds[i], hashId(oldIds[i]));
+            s.ids[j] = oldIds[i];
+            s.slots[j] = oldSlots[i];
+        }
+    }
+
+public:
+    AccountRegistry() {
+        for (unsigned i = 0; i < SHARDS; i++) {
+            shards[i].bits = 4;
+            shards[i].ids.assign(16, 0);
+            shards[i].slots.assign(16, nullptr);
+            shards[i].count = 0;
+        }
+    }
+
+    // Pre-size for an expected number of accounts (avoids rehashing while loading)
+    void reserve(size_t accounts) {
+        for (unsigned i = 0; i < SHARDS; i++) {
+            unique_lock<shared_mutex> guard(shards[i].lock);
+            while (((size_t)1 << shards[i].bits) < accounts * 2 / SHARDS + 16) grow(shards[i]);
+        }
+    }
+
+    // False if the id is already registered
+    bool insert(Account* acc) {
+        uint32_t id = acc->getId();
+        uint64_t h = hashId(id);
+        Shard& s = shards[h >> (64 - SHARD_BITS)];
+        unique_lock<shared_mutex> guard(s.lock);
+        if ((s.count + 1) * 2 > s.slots.size()) grow(s);
+        size_t i = probe(s, id, h);
+        if (s.slots[i] != nullptr) return false;
+        s.ids[i] = id;
+        s.slots[i] = acc;
+        s.count++;
+        return true;
+    }
+
+    // nullptr if not found
+    Account* find(uint32_t id) const {
+        uint64_t h = hashId(id);
+        const Shard& s = shards[h >> (64 - SHARD_BITS)];
+        shared_lock<shared_mutex> guard(s.lock);
+        return s.slots[probe(s, id, h)];
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (unsigned i = 0; i < SHARDS; i++) {
+            shared_lock<shared_mutex> guard(shards[i].lock);
+            total += shards[i].count;
+        }
+        return total;
+    }
+
+    size_t memoryBytes() const {
+        size_t total = 0;
+        for (unsigned i = 0; i < SHARDS; i++) {
+            shared_lock<shared_mutex> guard(shards[i].lock);
+            total += shards[i].slots.capacity() * (sizeof(Account*) + sizeof(uint32_t));
+        }
+        return total;
+    }
+};
+
+// ===== BANK =====
+class Bank {
+private:
+    vector<Account*> accounts;          // Required by the spec; owns the accounts
+    mutex accountsLock;                 // Guards push_back on the vector only
+    AccountRegistry registry;
+
+public:
+    ~Bank() {
+        for (size_t i = 0; i < accounts.size(); i++) delete accounts[i];
+    }
+
+    void reserve(size_t n) {
+        accounts.reserve(n);
+        registry.reserve(n);
+    }
+
+    bool addAccount(Account* acc) {
+        if (!registry.insert(acc)) {
+            cout << "Error: account " << acc->getId() << " already exists" << endl;
+            delete acc;
+            return false;
+        }
+        lock_guard<mutex> guard(accountsLock);
+        accounts.push_back(acc);
+        return true;
+    }
+
+    // O(1): registry
+    Account* findAccount(uint32_t id) const {
+        return registry.find(id);
+    }
+
+    // O(n): the spec's linear scan (baseline)
+    Account* findAccountLinear(uint32_t id) const {
+        for (size_t i = 0; i < accounts.size(); i++) {
+            if (accounts[i]->getId() == id) return accounts[i];
+        }
+        return nullptr;
+    }
+
+    bool deposit(uint32_t id, long long cents) {
+        Account* acc = findAccount(id);
+        if (acc == nullptr) {
+            cout << "Error: account " << id << " not found" << endl;
+            return false;
+        }
+        return acc->deposit(cents);
+    }
+
+    bool withdraw(uint32_t id, long long cents) {
+        Account* acc = findAccount(id);
+        if (acc == nullptr) {
+            cout << "Error: account " << id << " not found" << endl;
+            return false;
+        }
+        return acc->withdraw(cents);
+    }
+
+    bool transfer(uint32_t fromId, uint32_t toId, long long cents) {
+        Account* from = findAccount(fromId);
+        Account* to = findAccount(toId);
+        if (from == nullptr || to == nullptr) {
+            cout << "Error: account " << (from == nullptr ? fromId : toId) << " not found" << endl;
+            return false;
+        }
+        if (!(from->getPermissions() & CAN_TRANSFER)) return false;
+        // Check the recipient BEFORE withdrawing, so money is never taken out
+        // of 'from' with nowhere to go
+        if (!(to->getPermissions() & CAN_DEPOSIT) || cents <= 0) return false;
+        if (!from->withdraw(cents)) return false;
+        if (!to->deposit(cents)) {
+            from->deposit(cents);               // Put it back (never lose money)
+            return false;
+        }
+        return true;
+    }
+
+    size_t size() const { return accounts.size(); }
+    const AccountRegistry& index() const { return registry; }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Account ids are spread out (not 0..n-1) like real account numbers
+uint32_t idOf(uint32_t i) {
+    return 10000000u + i * 37u;
+}
+
+Account* makeAccount(uint32_t i) {
+    unsigned perms = CAN_DEPOSIT | CAN_WITHDRAW | CAN_TRANSFER;
+    if (i % 3 == 0) return new CurrentAccount(idOf(i), "acct" + to_string(i), perms, 10000, 50000);
+    return new SavingsAccount(idOf(i), "acct" + to_string(i), perms, 10000);
+}
+
+int main() {
+    cout << "===== BASIC OPERATIONS =====" << endl;
+    {
+        Bank bank;
+        bank.addAccount(new SavingsAccount(1001, "Ali", CAN_DEPOSIT | CAN_WITHDRAW | CAN_TRANSFER, 100000));
+        bank.addAccount(new CurrentAccount(1002, "Sara", CAN_DEPOSIT | CAN_WITHDRAW, 0, 50000));
+        bank.addAccount(new SavingsAccount(1001, "Duplicate", CAN_DEPOSIT, 0));
+        bank.addAccount(new SavingsAccount(1003, "Frozen", CAN_WITHDRAW, 0));   // Cannot receive
+        cout << "deposit 1002 25000      : " << (bank.deposit(1002, 25000) ? "OK" : "FAILED") << endl;
+        cout << "withdraw 1002 60000     : " << (bank.withdraw(1002, 60000) ? "OK" : "FAILED") << endl;
+        cout << "transfer 1001->1002 500 : " << (bank.transfer(1001, 1002, 500) ? "OK" : "FAILED") << endl;
+        cout << "transfer 1001->1003 700 : " << (bank.transfer(1001, 1003, 700) ? "OK" : "FAILED")
+             << " (1003 has no CAN_DEPOSIT)" << endl;
+        bool unknown = bank.deposit(4242, 100);
+        cout << "deposit 4242 100        : " << (unknown ? "OK" : "FAILED") << endl;
+        cout << "Balances: 1001 = " << bank.findAccount(1001)->getBalance()
+             << ", 1002 = " << bank.findAccount(1002)->getBalance()
+             << ", 1003 = " << bank.findAccount(1003)->getBalance() << endl;
+        bool conserved = bank.findAccount(1001)->getBalance() + bank.findAccount(1002)->getBalance()
+                       + bank.findAccount(1003)->getBalance() == 100000 + 25000 - 60000;   // Start + deposit - withdraw
+        cout << "Money conserved by transfers: " << (conserved ? "YES" : "NO") << endl;
+    }
+
+    cout << "\n===== LOOKUP COST AS THE BANK GROWS =====" << endl;
+    const uint32_t TOTAL = 10000000;
+    const size_t LOOKUPS = 2000000;
+    Bank bank;
+    bank.reserve(TOTAL);
+    uint32_t built = 0;
+    uint32_t checkpoints[] = {10000, 100000, 1000000, 10000000};
+    for (uint32_t target : checkpoints) {
+        while (built < target) bank.addAccount(makeAccount(built++));
+
+        unsigned seed = target;
+        size_t found = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t k = 0; k < LOOKUPS; k++) {
+            seed = seed * 1103515245u + 12345u;
+            found += bank.findAccount(idOf(seed % target)) != nullptr;
+        }
+        double registryNs = millisecondsSince(start) * 1e6 / LOOKUPS;
+
+        // Linear scan: only a handful of lookups (each one walks the vector)
+        const int SCANS = 20;
+        size_t linearFound = 0;
+        start = chrono::steady_clock::now();
+        for (int k = 0; k < SCANS; k++) {
+            seed = seed * 1103515245u + 12345u;
+            linearFound += bank.findAccountLinear(idOf(seed % target)) != nullptr;
+        }
+        double linearNs = millisecondsSince(start) * 1e6 / SCANS;
+
+        cout << target << " accounts: registry " << registryNs << " ns/lookup, linear scan "
+             << linearNs / 1000 << " us/lookup, all found: "
+             << (found == LOOKUPS && linearFound == (size_t)SCANS ? "YES" : "NO") << endl;
+    }
+    cout << "Registry memory: " << bank.index().memoryBytes() / (1 << 20) << " MB for " << bank.index().size()
+         << " accounts" << endl;
+    cout << "Unknown id 7: " << (bank.findAccount(7) == nullptr ? "not found (correct)" : "FOUND (wrong)") << endl;
+
+    cout << "\n===== READERS WHILE NEW ACCOUNTS ARE REGISTERED =====" << endl;
+    {
+        unsigned readers = thread::hardware_concurrency();
+        if (readers < 4) readers = 4;
+        const uint32_t NEW_ACCOUNTS = 500000;
+        atomic<size_t> missing(0);
+        atomic<size_t> lookups(0);
+
+        auto start = chrono::steady_clock::now();
+        thread writer([&]() {
+            for (uint32_t i = 0; i < NEW_ACCOUNTS; i++) bank.addAccount(makeAccount(TOTAL + i));
+        });
+        vector<thread> pool;
+        for (unsigned t = 0; t < readers; t++) {
+            pool.push_back(thread([&, t]() {
+                unsigned seed = 99 + t;
+                size_t localMissing = 0;
+                for (size_t k = 0; k < LOOKUPS / 2; k++) {
+                    seed = seed * 1103515245u + 12345u;
+                    localMissing += bank.findAccount(idOf(seed % TOTAL)) == nullptr;   // Existing ids only
+                }
+                missing += localMissing;
+                lookups += LOOKUPS / 2;
+            }));
+        }
+        writer.join();
+        for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+        double ms = millisecondsSince(start);
+
+        bool allNew = true;
+        for (uint32_t i = 0; i < NEW_ACCOUNTS && allNew; i++) allNew = bank.findAccount(idOf(TOTAL + i)) != nullptr;
+        cout << readers << " reader threads + 1 writer: " << lookups.load() << " lookups and " << NEW_ACCOUNTS
+             << " registrations in " << ms << " ms" << endl;
+        cout << "Readers never missed an existing account: " << (missing == 0 ? "YES" : "NO") << endl;
+        cout << "Every new account registered: " << (allNew && bank.size() == TOTAL + NEW_ACCOUNTS ? "YES" : "NO") << endl;
+    }
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Index Next to the Vector
+       - vector<Account*> stays the owner (spec requirement)
+       - Registry stores (id, pointer) pairs for O(1) lookup, no STL map
+
+    2. Open Addressing
+       - Keys and pointers in flat arrays, linear probing on collision
+       - Load factor <= 1/2 -> short probe sequences, no per-entry allocation
+
+    3. Fibonacci Hashing
+       - id * 0x9E3779B97F4A7C15: spreads nearby ids across the whole table
+       - Top 6 bits -> shard, next bits -> slot
+
+    4. Sharding
+       - 64 independent small tables, each with its own lock
+       - A writer blocks 1/64 of the lookups, growth rehashes 1/64 of the entries
+
+    5. Reader-Writer Lock (shared_mutex)
+       - shared_lock for find(): many readers at once
+       - unique_lock for insert(): exclusive, but only on one shard
+
+    6. Constant Time
+       - Cost per lookup barely changes from 10K to 10M accounts
+         (only cache misses grow), while the linear scan grows with n
+*/
@@ -0,0 +1,363 @@
+/*
+    8) TYPE-SEGREGATED ACCOUNT STORAGE (Devirtualized Bulk Operations)
+
+    Explanation:
+    - Classic design: vector<Account*> of mixed SavingsAccount / CurrentAccount
+          for (Account* a : accounts) a->applyMonthlyInterest();
+      -> one virtual call per account, the target alternates unpredictably
+         (branch mispredictions), nothing can be inlined or vectorized, and
+         every object is a separate heap allocation (pointer chasing)
+    - Data-oriented mode: each concrete type has its OWN store, and each field
+      is its own contiguous array (Structure of Arrays):
+          SavingsStore: ids[], balanceCents[], permissions[], names[]
+          CurrentStore: ids[], balanceCents[], overdraftCents[], permissions[], names[]
+    - Bulk operations dispatch ONCE PER TYPE, not once per object:
+          bank.accrueMonthlyInterest() -> savings.accrue(); current.accrue();
+      each one a tight loop over a plain array that the compiler vectorizes
+    - The polymorphic API stays as a facade: SavingsAccount / CurrentAccount
+      are small handles (store + slot) that still implement Account's virtual
+      deposit / withdraw / getBalance, so vector<Account*> code keeps working
+    - Interest in integer cents with a Q24 fixed-point monthly rate:
+          interest = (balance * rateQ24) >> 24     (floor, exact, same everywhere)
+      -> classic and segregated versions produce IDENTICAL balances
+
+    Compile with -O3 (GCC 12 only auto-vectorizes these loops at -O3) and
+    AVX2 so the accrual loops use 256-bit vectors:
+        g++ -O3 -mavx2 8_type_segregated_accounts.cpp
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+// ===== PERMISSION FLAGS =====
+const unsigned CAN_WITHDRAW = 1;
+const unsigned CAN_DEPOSIT = 2;
+const unsigned CAN_TRANSFER = 4;
+
+// ===== RATES (annual % -> monthly rate in Q24 fixed point) =====
+const int RATE_SHIFT = 24;
+const long long SAVINGS_RATE_Q24 = (long long)(0.04 / 12 * (1 << RATE_SHIFT) + 0.5);     // 4% on positive balances
+const long long OVERDRAFT_RATE_Q24 = (long long)(0.18 / 12 * (1 << RATE_SHIFT) + 0.5);   // 18% on overdrawn balances
+
+// Same formula in both designs: floor(balance * rate / 2^24)
+inline long long savingsInterest(long long balance) {
+    return (max(balance, 0LL) * SAVINGS_RATE_Q24) >> RATE_SHIFT;
+}
+
+inline long long overdraftCharge(long long balance) {
+    return (min(balance, 0LL) * OVERDRAFT_RATE_Q24) >> RATE_SHIFT;      // <= 0
+}
+
+// =====================================================================
+// CLASSIC DESIGN (baseline): one heap object per account, virtual calls
+// =====================================================================
+class ClassicAccount {
+protected:
+    uint32_t accountId;
+    string name;
+    unsigned permissions;
+    long long balanceCents;
+
+public:
+    ClassicAccount(uint32_t id, string n, unsigned perms, long long cents)
+        : accountId(id), name(n), permissions(perms), balanceCents(cents) {}
+    virtual ~ClassicAccount() {}
+    virtual void applyMonthlyInterest() = 0;
+    long long getBalance() const { return balanceCents; }
+};
+
+class ClassicSavings : public ClassicAccount {
+public:
+    ClassicSavings(uint32_t id, string n, unsigned perms, long long cents) : ClassicAccount(id, n, perms, cents) {}
+    void applyMonthlyInterest() override { balanceCents += savingsInterest(balanceCents); }
+};
+
+class ClassicCurrent : public ClassicAccount {
+private:
+    long long overdraftCents;
+
+public:
+    ClassicCurrent(uint32_t id, string n, unsigned perms, long long cents, long long overdraft)
+        : ClassicAccount(id, n, perms, cents), overdraftCents(overdraft) {}
+    void applyMonthlyInterest() override { balanceCents += overdraftCharge(balanceCents); }
+};
+
+// =====================================================================
+// TYPE-SEGREGATED DESIGN
+// =====================================================================
+
+// ----- Per-type stores (Structure of Arrays) -----
+struct SavingsStore {
+    vector<uint32_t> ids;
+    vector<long long> balanceCents;
+    vector<uint8_t> permissions;
+    vector<string> names;               // Cold: never touched by bulk loops
+
+    uint32_t add(uint32_t id, const string& n, unsigned perms, long long cents) {
+        ids.push_back(id);
+        balanceCents.push_back(cents);
+        permissions.push_back((uint8_t)perms);
+        names.push_back(n);
+        return (uint32_t)ids.size() - 1;
+    }
+
+    // Vectorizable: no calls, no branches, one array
+    void accrue() {
+        long long* b = balanceCents.data();
+        size_t n = balanceCents.size();
+        for (size_t i = 0; i < n; i++) b[i] += savingsInterest(b[i]);
+    }
+
+    long long total() const {
+        long long sum = 0;
+        for (size_t i = 0; i < balanceCents.size(); i++) sum += balanceCents[i];
+        return sum;
+    }
+};
+
+struct CurrentStore {
+    vector<uint32_t> ids;
+    vector<long long> balanceCents;
+    vector<long long> overdraftCents;
+    vector<uint8_t> permissions;
+    vector<string> names;
+
+    uint32_t add(uint32_t id, const string& n, unsigned perms, long long cents, long long overdraft) {
+        ids.push_back(id);
+        balanceCents.push_back(cents);
+        overdraftCents.push_back(overdraft);
+        permissions.push_back((uint8_t)perms);
+        names.push_back(n);
+        return (uint32_t)ids.size() - 1;
+    }
+
+    void accrue() {
+        long long* b = balanceCents.data();
+        size_t n = balanceCents.size();
+        for (size_t i = 0; i < n; i++) b[i] += overdraftCharge(b[i]);
+    }
+
+    long long total() const {
+        long long sum = 0;
+        for (size_t i = 0; i < balanceCents.size(); i++) sum += balanceCents[i];
+        return sum;
+    }
+};
+
+// ----- Polymorphic facade -----
+// Handles hold no account data, only where it lives
+class Account {
+public:
+    virtual ~Account() {}
+    virtual uint32_t getId() const = 0;
+    virtual long long getBalance() const = 0;
+    virtual bool deposit(long long cents) = 0;
+    virtual bool withdraw(long long cents) = 0;
+    virtual string type() const = 0;
+};
+
+class SavingsAccount : public Account {
+private:
+    SavingsStore* store;
+    uint32_t slot;
+
+public:
+    SavingsAccount(SavingsStore* s, uint32_t i) : store(s), slot(i) {}
+
+    uint32_t getId() const override { return store->ids[slot]; }
+    long long getBalance() const override { return store->balanceCents[slot]; }
+    string type() const override { return "Savings"; }
+
+    bool deposit(long long cents) override {
+        if (!(store->permissions[slot] & CAN_DEPOSIT) || cents <= 0) return false;
+        store->balanceCents[slot] += cents;
+        return true;
+    }
+
+    bool withdraw(long long cents) override {
+        if (!(store->permissions[slot] & CAN_WITHDRAW) || cents <= 0) return false;
+        if (store->balanceCents[slot] - cents < 0) return false;
+        store->balanceCents[slot] -= cents;
+        return true;
+    }
+};
+
+class CurrentAccount : public Account {
+private:
+    CurrentStore* store;
+    uint32_t slot;
+
+public:
+    CurrentAccount(CurrentStore* s, uint32_t i) : store(s), slot(i) {}
+
+    uint32_t getId() const override { return store->ids[slot]; }
+    long long getBalance() const override { return store->balanceCents[slot]; }
+    string type() const override { return "Current"; }
+
+    bool deposit(long long cents) override {
+        if (!(store->permissions[slot] & CAN_DEPOSIT) || cents <= 0) return false;
+        store->balanceCents[slot] += cents;
+        return true;
+    }
+
+    bool withdraw(long long cents) override {
+        if (!(store->permissions[slot] & CAN_WITHDRAW) || cents <= 0) return false;
+        if (store->balanceCents[slot] - cents < -store->overdraftCents[slot]) return false;
+        store->balanceCents[slot] -= cents;
+        return true;
+    }
+};
+
+// ----- Bank -----
+class Bank {
+private:
+    SavingsStore savings;
+    CurrentStore current;
+    vector<Account*> accounts;          // Facade, in creation order (mixed types)
+
+public:
+    ~Bank() {
+        for (size_t i = 0; i < accounts.size(); i++) delete accounts[i];
+    }
+
+    Account* openSavings(uint32_t id, const string& n, unsigned perms, long long cents) {
+        accounts.push_back(new SavingsAccount(&savings, savings.add(id, n, perms, cents)));
+        return accounts.back();
+    }
+
+    Account* openCurrent(uint32_t id, const string& n, unsigned perms, long long cents, long long overdraft) {
+        accounts.push_back(new CurrentAccount(&current, current.add(id, n, perms, cents, overdraft)));
+        return accounts.back();
+    }
+
+    // One dispatch per TYPE
+    void accrueMonthlyInterest() {
+        savings.accrue();
+        current.accrue();
+    }
+
+    long long totalBalance() const {
+        return savings.total() + current.total();
+    }
+
+    Account* at(size_t i) const { return accounts[i]; }
+    size_t size() const { return accounts.size(); }
+    size_t savingsCount() const { return savings.ids.size(); }
+    size_t currentCount() const { return current.ids.size(); }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== FACADE: SAME Account* API =====" << endl;
+    {
+        Bank bank;
+        Account* ali = bank.openSavings(1001, "Ali", CAN_DEPOSIT | CAN_WITHDRAW, 100000);
+        Account* sara = bank.openCurrent(1002, "Sara", CAN_DEPOSIT | CAN_WITHDRAW, 0, 50000);
+        sara->withdraw(40000);
+        ali->withdraw(500000);                      // Refused: savings cannot go below 0
+        ali->deposit(20000);
+        bank.accrueMonthlyInterest();
+        for (size_t i = 0; i < bank.size(); i++) {
+            cout << "  " << bank.at(i)->type() << " " << bank.at(i)->getId() << ": "
+                 << bank.at(i)->getBalance() << " cents" << endl;
+        }
+        cout << "  (Ali: 120000 + 0.333% = " << 120000 + savingsInterest(120000)
+             << ", Sara: -40000 - 1.5% = " << -40000 + overdraftCharge(-40000) << ")" << endl;
+    }
+
+    const size_t N = 4000000;
+    const int MONTHS = 12;
+    cout << "\n===== " << MONTHS << " MONTHS OF INTEREST, " << N << " ACCOUNTS =====" << endl;
+
+    // Same accounts in both designs; types interleaved pseudo-randomly
+    vector<ClassicAccount*> classic;
+    classic.reserve(N);
+    Bank bank;
+    unsigned seed = 7;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        bool isCurrent = (seed >> 16) % 10 < 3;                            // ~30% current accounts
+        long long cents = (long long)((seed >> 4) % 2000000) - (isCurrent ? 500000 : 0);
+        uint32_t id = 100000 + (uint32_t)i;
+        string name = "acct" + to_string(i);
+        unsigned perms = CAN_DEPOSIT | CAN_WITHDRAW | CAN_TRANSFER;
+        if (isCurrent) {
+            classic.push_back(new ClassicCurrent(id, name, perms, cents, 500000));
+            bank.openCurrent(id, name, perms, cents, 500000);
+        } else {
+            classic.push_back(new ClassicSavings(id, name, perms, cents));
+            bank.openSavings(id, name, perms, cents);
+        }
+    }
+    cout << bank.savingsCount() << " savings + " << bank.currentCount() << " current accounts" << endl;
+
+    auto start = chrono::steady_clock::now();
+    for (int m = 0; m < MONTHS; m++) {
+        for (size_t i = 0; i < classic.size(); i++) classic[i]->applyMonthlyInterest();
+    }
+    double classicMs = millisecondsSince(start);
+
+    // Facade loop: still one virtual call per account, now on the new storage
+    start = chrono::steady_clock::now();
+    long long facadeTotal = 0;
+    for (size_t i = 0; i < bank.size(); i++) facadeTotal += bank.at(i)->getBalance();
+    double facadeMs = millisecondsSince(start);
+
+    start = chrono::steady_clock::now();
+    for (int m = 0; m < MONTHS; m++) bank.accrueMonthlyInterest();
+    double segregatedMs = millisecondsSince(start);
+
+    bool same = true;
+    long long classicTotal = 0;
+    for (size_t i = 0; i < N; i++) {
+        classicTotal += classic[i]->getBalance();
+        if (classic[i]->getBalance() != bank.at(i)->getBalance()) same = false;
+    }
+
+    cout << "Virtual call per account   : " << classicMs << " ms" << endl;
+    cout << "One dispatch per type (SoA): " << segregatedMs << " ms (" << classicMs / segregatedMs << "x faster)" << endl;
+    cout << "(one pass of virtual getBalance() over the facade: " << facadeMs << " ms)" << endl;
+    cout << "Every balance identical: " << (same ? "YES" : "NO") << endl;
+    cout << "Total after interest: " << bank.totalBalance() << " cents, classic: " << classicTotal
+         << (bank.totalBalance() == classicTotal ? " (match)" : " (MISMATCH)") << endl;
+    cout << "Facade total before interest: " << facadeTotal << " cents" << endl;
+
+    for (size_t i = 0; i < classic.size(); i++) delete classic[i];
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Why Virtual Calls Hurt in Bulk
+       - Indirect call per object, target alternates Savings/Current -> mispredicts
+       - Compiler cannot inline or vectorize across an unknown call target
+
+    2. Type Segregation
+       - All savings accounts together, all current accounts together
+       - The type is known per ARRAY, so the loop body is fixed code
+
+    3. Structure of Arrays
+       - balanceCents[] is contiguous: 8 bytes per account, no names or vptrs
+         dragged through the cache
+       - Cold fields (names) live in their own array
+
+    4. Dispatch Once per Type
+       - accrueMonthlyInterest() = two loops, not N virtual calls
+
+    5. Branch-Free Fixed-Point Interest
+       - max / min instead of if -> compiles to vector min/max
+       - (balance * rateQ24) >> 24: integer only, exact, deterministic
+
+    6. Facade
+       - Account* handles still give deposit / withdraw / getBalance per account
+       - Old code keeps working; bulk code uses the stores directly
+*/
@@ -0,0 +1,462 @@
+/*
+    10) COLUMN COMPRESSION: DICTIONARY, FRAME-OF-REFERENCE, BIT-PACKING, RLE
+
+    Explanation:
+    - Row stores every value as a full std::string (32-byte header + heap text)
+    - Per-column encodings store the same information in far fewer bits:
+      -> DICTIONARY (strings): distinct values stored once, rows store small codes
+      -> FRAME-OF-REFERENCE (ints): store (value - min) instead of value
+      -> BIT-PACKING: store each code/offset in exactly the bits it needs
+         (ages 18..67 -> offsets 0..49 -> 6 bits instead of 32)
+      -> RLE (run-length): sorted columns become (value, runLength) pairs
+    - A simple planner looks at each column's statistics and picks the encoding
+    - Predicates run on ENCODED data:
+      -> name = 'Ali'   : look up Ali's code once, compare small integers
+      -> age > 30       : compare (age - min) against (30 - min), no decoding
+      -> RLE column     : test each RUN once, add its length
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+using namespace std;
+
+enum CompareOp { OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE };
+
+template <typename T>
+bool compareValues(const T& a, CompareOp op, const T& b) {
+    switch (op) {
+        case OP_EQ: return a == b;
+        case OP_NE: return a != b;
+        case OP_LT: return a < b;
+        case OP_LE: return a <= b;
+        case OP_GT: return a > b;
+        case OP_GE: return a >= b;
+    }
+    return false;
+}
+
+// Number of bits needed to store values 0..maxValue
+int bitsNeeded(uint64_t maxValue) {
+    int bits = 0;
+    while (maxValue >> bits) bits++;
+    return bits == 0 ? 1 : bits;
+}
+
+// ===== BIT-PACKED ARRAY =====
+// Value i occupies bits [i*width, (i+1)*width) of a uint64_t array.
+class BitPacked {
+private:
+    vector<uint64_t> words;
+    int width;
+    uint64_t mask;
+    size_t count;
+
+public:
+    BitPacked() : width(1), mask(1), count(0) {}
+
+    void init(int bitWidth, size_t n) {
+        width = bitWidth;
+        mask = (bitWidth == 64) ? ~0ULL : ((1ULL << bitWidth) - 1);
+        count = n;
+        words.assign((n * bitWidth + 63) / 64 + 1, 0);   // +1: reads never run off the end
+    }
+
+    void set(size_t i, uint64_t v) {
+        size_t bit = i * width;
+        size_t w = bit >> 6;
+        int shift = bit & 63;
+        words[w] |= (v & mask) << shift;
+        if (shift + width > 64) words[w + 1] |= (v & mask) >> (64 - shift);
+    }
+
+    uint64_t get(size_t i) const {
+        size_t bit = i * width;
+        size_t w = bit >> 6;
+        int shift = bit & 63;
+        uint64_t v = words[w] >> shift;
+        if (shift + width > 64) v |= words[w + 1] << (64 - shift);
+        return v & mask;
+    }
+
+    int bitWidth() const { return width; }
+    size_t size() const { return count; }
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+};
+
+// ===== PREDICATE AS A CODE RANGE =====
+// Every comparison against a constant selects a contiguous range [lo, hi]
+// of codes (NE is the complement of EQ). Counting a range needs ONE
+// branch-free unsigned compare per row:  (x - lo) <= (hi - lo)
+size_t countInRange(const BitPacked& packed, CompareOp op, int64_t c) {
+    int64_t maxCode = (packed.bitWidth() >= 63) ? INT64_MAX : (int64_t)((1ULL << packed.bitWidth()) - 1);
+    int64_t lo = 0, hi = maxCode;
+    switch (op) {
+        case OP_EQ: case OP_NE: lo = hi = c; break;
+        case OP_LT: hi = c - 1; break;
+        case OP_LE: hi = c; break;
+        case OP_GT: lo = c + 1; break;
+        case OP_GE: lo = c; break;
+    }
+    if (lo < 0) lo = 0;
+    if (hi > maxCode) hi = maxCode;
+
+    size_t count = 0;
+    if (lo <= hi) {
+        uint64_t ulo = (uint64_t)lo, span = (uint64_t)(hi - lo);
+        for (size_t i = 0; i < packed.size(); i++) count += (packed.get(i) - ulo) <= span;
+    }
+    return op == OP_NE ? packed.size() - count : count;
+}
+
+// ===== ENCODED INT COLUMN =====
+enum IntEncoding { INT_FOR_BITPACK, INT_RLE };
+
+class IntColumn {
+public:
+    string name;
+    IntEncoding encoding;
+    size_t rowCount;
+
+    // Frame-of-reference + bit-packing
+    int base;
+    BitPacked packed;
+
+    // RLE
+    vector<int> runValues;
+    vector<uint32_t> runLengths;
+
+    // Planner: RLE if runs are long, otherwise FOR + bit-packing
+    void encode(const string& columnName, const vector<int>& values) {
+        name = columnName;
+        rowCount = values.size();
+        size_t runs = 0;
+        int minValue = values.empty() ? 0 : values[0], maxValue = minValue;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i == 0 || values[i] != values[i - 1]) runs++;
+            if (values[i] < minValue) minValue = values[i];
+            if (values[i] > maxValue) maxValue = values[i];
+        }
+
+        if (runs * 8 <= values.size()) {                  // Average run >= 8 rows
+            encoding = INT_RLE;
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i == 0 || values[i] != values[i - 1]) {
+                    runValues.push_back(values[i]);
+                    runLengths.push_back(0);
+                }
+                runLengths.back()++;
+            }
+        } else {
+            encoding = INT_FOR_BITPACK;
+            base = minValue;
+            packed.init(bitsNeeded((uint64_t)((int64_t)maxValue - minValue)), values.size());
+            for (size_t i = 0; i < values.size(); i++) packed.set(i, (uint64_t)((int64_t)values[i] - base));
+        }
+    }
+
+    int get(size_t i) const {
+        // In 64 bits: the offset may exceed INT_MAX when the column spans INT_MIN..INT_MAX
+        if (encoding == INT_FOR_BITPACK) return (int)((int64_t)base + (int64_t)packed.get(i));
+        for (size_t r = 0; r < runLengths.size(); r++) {
+            if (i < runLengths[r]) return runValues[r];
+            i -= runLengths[r];
+        }
+        return 0;
+    }
+
+    // COUNT(*) WHERE column <op> c, evaluated on encoded data
+    size_t countWhere(CompareOp op, int c) const {
+        size_t count = 0;
+        if (encoding == INT_RLE) {
+            for (size_t r = 0; r < runValues.size(); r++) {
+                if (compareValues(runValues[r], op, c)) count += runLengths[r];
+            }
+            return count;
+        }
+        // Shift the constant into the frame: value > c  <=>  (value - base) > (c - base)
+        return countInRange(packed, op, (int64_t)c - base);
+    }
+
+    string describe() const {
+        if (encoding == INT_RLE) return "RLE (" + to_string(runValues.size()) + " runs)";
+        return "FOR base=" + to_string(base) + " + bit-pack " + to_string(packed.bitWidth()) + " bits";
+    }
+
+    size_t bytes() const {
+        if (encoding == INT_RLE) return runValues.size() * (sizeof(int) + sizeof(uint32_t));
+        return packed.bytes();
+    }
+};
+
+// ===== ENCODED STRING COLUMN =====
+enum StringEncoding { STR_PLAIN, STR_DICTIONARY, STR_DICTIONARY_RLE };
+
+class StringColumn {
+public:
+    string name;
+    StringEncoding encoding;
+    size_t rowCount;
+
+    vector<string> plain;             // STR_PLAIN
+    vector<string> dictionary;        // Sorted distinct values: code order == string order
+    BitPacked codes;                  // STR_DICTIONARY
+    vector<uint32_t> runCodes;        // STR_DICTIONARY_RLE
+    vector<uint32_t> runLengths;
+
+    uint32_t codeOf(const string& s) const {
+        return (uint32_t)(lower_bound(dictionary.begin(), dictionary.end(), s) - dictionary.begin());
+    }
+
+    void encode(const string& columnName, const vector<string>& values) {
+        name = columnName;
+        rowCount = values.size();
+        dictionary = values;
+        sort(dictionary.begin(), dictionary.end());
+        dictionary.erase(unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+        // Planner: dictionary only pays off if values repeat
+        if (dictionary.size() * 2 > values.size()) {
+            encoding = STR_PLAIN;
+            plain = values;
+            dictionary.clear();
+            return;
+        }
+
+        size_t runs = 0;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i == 0 || values[i] != values[i - 1]) runs++;
+        }
+        if (runs * 8 <= values.size()) {
+            encoding = STR_DICTIONARY_RLE;
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i == 0 || values[i] != values[i - 1]) {
+                    runCodes.push_back(codeOf(values[i]));
+                    runLengths.push_back(0);
+                }
+                runLengths.back()++;
+            }
+        } else {
+            encoding = STR_DICTIONARY;
+            codes.init(bitsNeeded(dictionary.size() - 1), values.size());
+            for (size_t i = 0; i < values.size(); i++) codes.set(i, codeOf(values[i]));
+        }
+    }
+
+    string get(size_t i) const {
+        if (encoding == STR_PLAIN) return plain[i];
+        if (encoding == STR_DICTIONARY) return dictionary[codes.get(i)];
+        for (size_t r = 0; r < runLengths.size(); r++) {
+            if (i < runLengths[r]) return dictionary[runCodes[r]];
+            i -= runLengths[r];
+        }
+        return "";
+    }
+
+    // Translate a string predicate into a code predicate.
+    // The dictionary is sorted, so  s < "M"  <=>  code < lower_bound("M").
+    // Returns false when the constant is not in the dictionary and op is = or !=
+    // (then 'allMatch' tells the answer for every row).
+    bool translate(CompareOp& op, const string& c, uint32_t& code, bool& allMatch) const {
+        code = codeOf(c);
+        bool present = code < dictionary.size() && dictionary[code] == c;
+        if (present) return true;
+        if (op == OP_EQ || op == OP_NE) {
+            allMatch = (op == OP_NE);
+            return false;
+        }
+        // Constant falls between dictionary entries code-1 and code
+        if (op == OP_LE) op = OP_LT;          // s <= c  <=>  code < lower_bound(c)
+        if (op == OP_GT) op = OP_GE;          // s > c   <=>  code >= lower_bound(c)
+        return true;
+    }
+
+    size_t countWhere(CompareOp op, const string& c) const {
+        size_t count = 0;
+        if (encoding == STR_PLAIN) {
+            for (size_t i = 0; i < rowCount; i++) count += compareValues(plain[i], op, c);
+            return count;
+        }
+        uint32_t code;
+        bool allMatch = false;
+        if (!translate(op, c, code, allMatch)) return allMatch ? rowCount : 0;
+
+        if (encoding == STR_DICTIONARY_RLE) {
+            for (size_t r = 0; r < runCodes.size(); r++) {
+                if (compareValues(runCodes[r], op, code)) count += runLengths[r];
+            }
+            return count;
+        }
+        return countInRange(codes, op, code);
+    }
+
+    string describe() const {
+        if (encoding == STR_PLAIN) return "PLAIN";
+        string d = "DICTIONARY (" + to_string(dictionary.size()) + " values";
+        if (encoding == STR_DICTIONARY) return d + ", " + to_string(codes.bitWidth()) + "-bit codes)";
+        return d + ") + RLE (" + to_string(runCodes.size()) + " runs)";
+    }
+
+    size_t bytes() const {
+        size_t total = 0;
+        for (size_t i = 0; i < dictionary.size(); i++) total += sizeof(string) + dictionary[i].capacity();
+        if (encoding == STR_PLAIN) {
+            for (size_t i = 0; i < plain.size(); i++) {
+                total += sizeof(string) + (plain[i].capacity() > 15 ? plain[i].capacity() + 1 : 0);
+            }
+        }
+        if (encoding == STR_DICTIONARY) total += codes.bytes();
+        if (encoding == STR_DICTIONARY_RLE) total += runCodes.size() * 2 * sizeof(uint32_t);
+        return total;
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const size_t N = 1000000;
+    const char* names[] = {"Ali", "Sara", "Omar", "Hina", "Bilal", "Ayesha", "Zain", "Fatima"};
+    const char* cities[] = {"Islamabad", "Karachi", "Lahore", "Multan", "Peshawar", "Quetta"};
+
+    // Source data: users(id, name, age, city, signup_day) - city and day sorted
+    vector<int> id(N), age(N), day(N);
+    vector<string> name(N), city(N), email(N);
+    unsigned seed = 99;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        id[i] = 100000 + (int)i;
+        age[i] = 18 + (int)((seed >> 8) % 50);
+        name[i] = names[(seed >> 16) % 8];
+        city[i] = cities[i * 6 / N];
+        day[i] = (int)(i / 2000);
+        email[i] = "user" + to_string(i) + "@mail.com";
+    }
+
+    cout << "===== PLANNER CHOICES =====" << endl;
+    IntColumn idCol, ageCol, dayCol;
+    StringColumn nameCol, cityCol, emailCol;
+    idCol.encode("id", id);
+    ageCol.encode("age", age);
+    dayCol.encode("signup_day", day);
+    nameCol.encode("name", name);
+    cityCol.encode("city", city);
+    emailCol.encode("email", email);
+
+    IntColumn* ints[] = {&idCol, &ageCol, &dayCol};
+    StringColumn* strs[] = {&nameCol, &cityCol, &emailCol};
+    size_t plainBytes = 0, encodedBytes = 0;
+    for (int k = 0; k < 3; k++) {
+        size_t raw = N * sizeof(string);                         // Row stores ints as strings too
+        cout << left << setw(12) << ints[k]->name << setw(45) << ints[k]->describe()
+             << raw / 1024 << " KB -> " << ints[k]->bytes() / 1024 << " KB" << endl;
+        plainBytes += raw;
+        encodedBytes += ints[k]->bytes();
+    }
+    for (int k = 0; k < 3; k++) {
+        StringColumn raw;
+        raw.encoding = STR_PLAIN;
+        raw.plain = (k == 0) ? name : (k == 1 ? city : email);
+        size_t rawBytes = raw.bytes();
+        cout << left << setw(12) << strs[k]->name << setw(45) << strs[k]->describe()
+             << rawBytes / 1024 << " KB -> " << strs[k]->bytes() / 1024 << " KB" << endl;
+        plainBytes += rawBytes;
+        encodedBytes += strs[k]->bytes();
+    }
+    cout << right << "Total: " << plainBytes / (1024 * 1024) << " MB as strings -> "
+         << encodedBytes / (1024 * 1024) << " MB encoded (" << fixed << setprecision(1)
+         << (double)plainBytes / encodedBytes << "x smaller)" << endl;
+    cout << setprecision(3);
+
+    cout << "\n===== ROUND TRIP CHECK =====" << endl;
+    bool ok = true;
+    for (size_t i = 0; i < N; i += 997) {
+        ok = ok && idCol.get(i) == id[i] && ageCol.get(i) == age[i] && dayCol.get(i) == day[i] &&
+             nameCol.get(i) == name[i] && cityCol.get(i) == city[i] && emailCol.get(i) == email[i];
+    }
+    {
+        // Full int range in one column: offsets up to 2^32 - 1 must decode without overflow
+        vector<int> extremes = {INT_MIN, -1, 0, 1, INT_MAX, INT_MIN + 1, INT_MAX - 1, 42, -42, 7};
+        IntColumn wide;
+        wide.encode("wide", extremes);
+        for (size_t i = 0; i < extremes.size(); i++) ok = ok && wide.get(i) == extremes[i];
+    }
+    cout << "Decoded values match source: " << (ok ? "YES" : "NO") << endl;
+
+    cout << "\n===== PREDICATES ON ENCODED DATA vs PLAIN STRINGS =====" << endl;
+    struct StrQuery { StringColumn* col; const vector<string>* raw; CompareOp op; string value; const char* text; };
+    StrQuery sq[] = {
+        {&nameCol, &name, OP_EQ, "Ali", "name = 'Ali'"},
+        {&nameCol, &name, OP_LT, "Hina", "name < 'Hina'"},
+        {&nameCol, &name, OP_EQ, "Nobody", "name = 'Nobody'"},
+        {&cityCol, &city, OP_GE, "Lahore", "city >= 'Lahore'"},
+        {&cityCol, &city, OP_GT, "Lahore", "city > 'Lahore'"},
+        {&cityCol, &city, OP_LE, "Kohat", "city <= 'Kohat'"},
+    };
+    for (size_t q = 0; q < sizeof(sq) / sizeof(sq[0]); q++) {
+        auto start = chrono::steady_clock::now();
+        size_t expected = 0;
+        for (size_t i = 0; i < N; i++) expected += compareValues((*sq[q].raw)[i], sq[q].op, sq[q].value);
+        double plainMs = millisecondsSince(start);
+        start = chrono::steady_clock::now();
+        size_t got = sq[q].col->countWhere(sq[q].op, sq[q].value);
+        double encMs = millisecondsSince(start);
+        cout << left << setw(20) << sq[q].text << right << setw(8) << got << " rows  plain " << setw(8)
+             << plainMs << " ms  encoded " << setw(8) << encMs << " ms  " << (got == expected ? "OK" : "MISMATCH") << endl;
+    }
+
+    struct IntQuery { IntColumn* col; const vector<int>* raw; CompareOp op; int value; const char* text; };
+    IntQuery iq[] = {
+        {&ageCol, &age, OP_GT, 30, "age > 30"},
+        {&ageCol, &age, OP_LT, 10, "age < 10"},
+        {&dayCol, &day, OP_EQ, 42, "signup_day = 42"},
+        {&idCol, &id, OP_GE, 600000, "id >= 600000"},
+    };
+    for (size_t q = 0; q < sizeof(iq) / sizeof(iq[0]); q++) {
+        size_t expected = 0;
+        for (size_t i = 0; i < N; i++) expected += compareValues((*iq[q].raw)[i], iq[q].op, iq[q].value);
+        auto start = chrono::steady_clock::now();
+        size_t got = iq[q].col->countWhere(iq[q].op, iq[q].value);
+        double encMs = millisecondsSince(start);
+        cout << left << setw(20) << iq[q].text << right << setw(8) << got << " rows  encoded "
+             << setw(8) << encMs << " ms  " << (got == expected ? "OK" : "MISMATCH") << endl;
+    }
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Dictionary Encoding
+       - Distinct strings stored once in a sorted dictionary
+       - Each row stores a code (index into the dictionary)
+       - 8 distinct names -> 3-bit codes instead of 32+ bytes per string
+
+    2. Sorted Dictionary = Order-Preserving Codes
+       - "Ali" < "Hina" exactly when code(Ali) < code(Hina)
+       - Range predicates (<, >=) compare codes, never strings
+
+    3. Frame-of-Reference (FOR)
+       - Store value - min, so small ranges need few bits
+       - Predicate constant is shifted by the same min instead of decoding rows
+
+    4. Bit-Packing
+       - Value i lives at bit offset i * width across uint64_t words
+       - get(): shift right, OR in the next word if the value straddles two words, mask
+       - Any comparison is a code range [lo, hi]: (x - lo) <= (hi - lo) as unsigned
+
+    5. Run-Length Encoding (RLE)
+       - Sorted/clustered columns: (value, runLength) pairs
+       - 1M rows with 6 cities -> 6 runs; a predicate is evaluated 6 times, not 1M
+
+    6. Automatic Choice (Planner)
+       - Few distinct strings    -> dictionary (plain if mostly unique, e.g. email)
+       - Long runs               -> RLE
+       - Otherwise (ints)        -> frame-of-reference + bit-packing
+*/
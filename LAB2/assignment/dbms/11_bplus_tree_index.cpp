@@ -0,0 +1,542 @@
+/*
+    11) B+-TREE SECONDARY INDEXES (Range Scans + ORDER BY)
+
+    Explanation:
+    - Hash index (2_hash_index.cpp) answers only  WHERE col = value
+    - WHERE age > 20 AND age < 30  or  ORDER BY name  still need a full scan + sort
+    - B+-tree: a sorted, balanced search tree
+      -> inner nodes only guide the search (separator keys + child pointers)
+      -> ALL entries live in the leaves, and leaves are chained left to right
+    - Range query = descend once (log n) + walk the leaf chain (output size)
+    - ORDER BY = walk the leaf chain from the first leaf, already sorted
+    - Nodes are aligned to 64 bytes and hold 16 entries. An int entry is
+      8 bytes, so an int node's entries fill 2 cache lines. A string entry
+      is a std::string + row id (40 bytes, 10 lines per node), and keys
+      longer than the 15-char short-string buffer add a heap read per compare
+    - CREATE INDEX bulk-loads from sorted input: leaves are filled left to right
+      and inner levels are built bottom-up (no splits, fully packed nodes)
+    - Later INSERTs keep the index up to date with normal B+-tree node splits
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// ===== B+-TREE =====
+// Entry = (key, rowId). Duplicate keys are allowed because the rowId
+// makes every entry unique (ties are ordered by rowId).
+template <typename Key>
+class BPlusTree {
+public:
+    struct Entry {
+        Key key;
+        uint32_t row;
+
+        bool operator<(const Entry& o) const {
+            return key < o.key || (!(o.key < key) && row < o.row);
+        }
+    };
+
+private:
+    static const int CAPACITY = 16;   // Entries per leaf, separators per inner node
+
+    struct alignas(64) Node {
+        bool isLeaf;
+        int count;                    // Leaf: entries, Inner: separators
+    };
+
+    struct alignas(64) Leaf : Node {
+        Entry entries[CAPACITY];
+        Leaf* next;                   // Leaf chain for range scans
+    };
+
+    struct alignas(64) Inner : Node {
+        Entry separators[CAPACITY];
+        Node* children[CAPACITY + 1]; // child i holds entries in [sep[i-1], sep[i])
+    };
+
+    Node* root;
+    Leaf* firstLeaf;
+    size_t entryCount;
+    size_t nodeCount;
+    int height;
+
+    Leaf* newLeaf() {
+        Leaf* l = new Leaf();
+        l->isLeaf = true;
+        l->count = 0;
+        l->next = nullptr;
+        nodeCount++;
+        return l;
+    }
+
+    Inner* newInner() {
+        Inner* n = new Inner();
+        n->isLeaf = false;
+        n->count = 0;
+        nodeCount++;
+        return n;
+    }
+
+    void destroy(Node* n) {
+        if (!n) return;
+        if (n->isLeaf) {
+            delete (Leaf*)n;
+            return;
+        }
+        Inner* in = (Inner*)n;
+        for (int i = 0; i <= in->count; i++) destroy(in->children[i]);
+        delete in;
+    }
+
+    // Index of the child to follow for 'e' (first separator greater than e)
+    static int childIndex(const Inner* in, const Entry& e) {
+        return (int)(upper_bound(in->separators, in->separators + in->count, e) - in->separators);
+    }
+
+    // Recursive insert. If 'n' splits, returns true and fills (upSep, upNode)
+    // with the separator and new right sibling for the parent.
+    bool insertInto(Node* n, const Entry& e, Entry& upSep, Node*& upNode) {
+        if (n->isLeaf) {
+            Leaf* leaf = (Leaf*)n;
+            Leaf* target = leaf;
+            bool split = false;
+            if (leaf->count == CAPACITY) {
+                // Split: right half moves to a new leaf
+                Leaf* right = newLeaf();
+                int mid = CAPACITY / 2;
+                for (int i = mid; i < CAPACITY; i++) right->entries[i - mid] = leaf->entries[i];
+                right->count = CAPACITY - mid;
+                leaf->count = mid;
+                right->next = leaf->next;
+                leaf->next = right;
+                upSep = right->entries[0];
+                upNode = right;
+                split = true;
+                if (!(e < right->entries[0])) target = right;
+            }
+            int pos = (int)(upper_bound(target->entries, target->entries + target->count, e) - target->entries);
+            for (int i = target->count; i > pos; i--) target->entries[i] = target->entries[i - 1];
+            target->entries[pos] = e;
+            target->count++;
+            return split;
+        }
+
+        Inner* in = (Inner*)n;
+        int i = childIndex(in, e);
+        Entry childSep;
+        Node* childNew = nullptr;
+        if (!insertInto(in->children[i], e, childSep, childNew)) return false;
+
+        // Child split: add (childSep, childNew) right after child i
+        Inner* target = in;
+        bool split = false;
+        if (in->count == CAPACITY) {
+            Inner* right = newInner();
+            int mid = CAPACITY / 2;
+            upSep = in->separators[mid];                  // Moves UP, kept in neither half
+            for (int k = mid + 1; k < CAPACITY; k++) right->separators[k - mid - 1] = in->separators[k];
+            for (int k = mid + 1; k <= CAPACITY; k++) right->children[k - mid - 1] = in->children[k];
+            right->count = CAPACITY - mid - 1;
+            in->count = mid;
+            upNode = right;
+            split = true;
+            if (i > mid) {
+                target = right;
+                i -= mid + 1;
+            }
+        }
+        for (int k = target->count; k > i; k--) target->separators[k] = target->separators[k - 1];
+        for (int k = target->count + 1; k > i + 1; k--) target->children[k] = target->children[k - 1];
+        target->separators[i] = childSep;
+        target->children[i + 1] = childNew;
+        target->count++;
+        return split;
+    }
+
+    // Leaf + position of the first entry >= probe
+    Leaf* seek(const Entry& probe, int& pos) const {
+        Node* n = root;
+        while (!n->isLeaf) n = ((Inner*)n)->children[childIndex((Inner*)n, probe)];
+        Leaf* leaf = (Leaf*)n;
+        pos = (int)(lower_bound(leaf->entries, leaf->entries + leaf->count, probe) - leaf->entries);
+        if (pos == leaf->count && leaf->next) {
+            leaf = leaf->next;
+            pos = 0;
+        }
+        return leaf;
+    }
+
+public:
+    BPlusTree() : root(nullptr), firstLeaf(nullptr), entryCount(0), nodeCount(0), height(0) {
+        clear();
+    }
+
+    ~BPlusTree() {
+        destroy(root);
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    void clear() {
+        destroy(root);
+        nodeCount = 0;
+        firstLeaf = newLeaf();
+        root = firstLeaf;
+        entryCount = 0;
+        height = 1;
+    }
+
+    // Bulk load from entries sorted by (key, row)
+    void bulkLoad(const vector<Entry>& sorted) {
+        clear();
+        if (sorted.empty()) return;
+
+        // 1) Pack leaves left to right
+        vector<Node*> level;
+        vector<Entry> lowKeys;        // Smallest entry under each node
+        Leaf* prev = nullptr;
+        for (size_t i = 0; i < sorted.size(); i += CAPACITY) {
+            Leaf* leaf = (i == 0) ? firstLeaf : newLeaf();
+            size_t n = min((size_t)CAPACITY, sorted.size() - i);
+            for (size_t k = 0; k < n; k++) leaf->entries[k] = sorted[i + k];
+            leaf->count = (int)n;
+            if (prev) prev->next = leaf;
+            prev = leaf;
+            level.push_back(leaf);
+            lowKeys.push_back(sorted[i]);
+        }
+
+        // 2) Build inner levels bottom-up until one node remains
+        while (level.size() > 1) {
+            vector<Node*> parents;
+            vector<Entry> parentLow;
+            for (size_t i = 0; i < level.size(); i += CAPACITY + 1) {
+                Inner* in = newInner();
+                size_t n = min((size_t)CAPACITY + 1, level.size() - i);
+                for (size_t k = 0; k < n; k++) {
+                    in->children[k] = level[i + k];
+                    if (k > 0) in->separators[k - 1] = lowKeys[i + k];
+                }
+                in->count = (int)n - 1;
+                parents.push_back(in);
+                parentLow.push_back(lowKeys[i]);
+            }
+            level.swap(parents);
+            lowKeys.swap(parentLow);
+            height++;
+        }
+        root = level[0];
+        entryCount = sorted.size();
+    }
+
+    void insert(const Key& key, uint32_t row) {
+        Entry e = {key, row};
+        Entry sep;
+        Node* sibling = nullptr;
+        if (insertInto(root, e, sep, sibling)) {
+            // Root split: tree grows one level at the TOP
+            Inner* newRoot = newInner();
+            newRoot->children[0] = root;
+            newRoot->children[1] = sibling;
+            newRoot->separators[0] = sep;
+            newRoot->count = 1;
+            root = newRoot;
+            height++;
+        }
+        entryCount++;
+    }
+
+    // Visit entries with lo <(=) key <(=) hi in key order.
+    // visit(row) returns false to stop early (LIMIT).
+    template <typename Visit>
+    void rangeScan(const Key& lo, bool loInclusive, const Key& hi, bool hiInclusive, Visit visit) const {
+        Entry probe = {lo, loInclusive ? 0u : 0xFFFFFFFFu};
+        int pos;
+        Leaf* leaf = seek(probe, pos);
+        for (; leaf; leaf = leaf->next, pos = 0) {
+            for (; pos < leaf->count; pos++) {
+                const Entry& e = leaf->entries[pos];
+                if (!loInclusive && !(lo < e.key)) continue;
+                if (hi < e.key || (!hiInclusive && !(e.key < hi))) return;
+                if (!visit(e.row)) return;
+            }
+        }
+    }
+
+    // Visit every entry in key order (ORDER BY)
+    template <typename Visit>
+    void scanAll(Visit visit) const {
+        for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; i++) {
+                if (!visit(leaf->entries[i].row)) return;
+            }
+        }
+    }
+
+    // Check sorted leaf chain and entry count (used by the demo)
+    bool verify() const {
+        size_t seen = 0;
+        const Entry* last = nullptr;
+        for (Leaf* leaf = firstLeaf; leaf; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; i++) {
+                if (last && !(*last < leaf->entries[i])) return false;
+                last = &leaf->entries[i];
+                seen++;
+            }
+        }
+        return seen == entryCount;
+    }
+
+    size_t size() const { return entryCount; }
+    int levels() const { return height; }
+    size_t nodes() const { return nodeCount; }
+};
+
+// ===== TABLE WITH SECONDARY INDEXES =====
+class Table {
+public:
+    string tableName;
+    vector<int> id;
+    vector<string> name;
+    vector<int> age;
+
+private:
+    // One slot per column: which buffer holds it, and its index (nullptr = none)
+    struct ColumnSlot {
+        string name;
+        vector<int>* ints;            // Exactly one of ints / strings is set
+        vector<string>* strings;
+        BPlusTree<int>* intIndex;
+        BPlusTree<string>* stringIndex;
+    };
+    vector<ColumnSlot> columns;
+
+    void addColumn(const string& n, vector<int>* ints, vector<string>* strings) {
+        ColumnSlot slot = {n, ints, strings, nullptr, nullptr};
+        columns.push_back(slot);
+    }
+
+public:
+    Table(string n) : tableName(n) {
+        addColumn("id", &id, nullptr);
+        addColumn("name", nullptr, &name);
+        addColumn("age", &age, nullptr);
+    }
+
+    ~Table() {
+        for (size_t c = 0; c < columns.size(); c++) {
+            delete columns[c].intIndex;
+            delete columns[c].stringIndex;
+        }
+    }
+
+    Table(const Table&) = delete;
+    Table& operator=(const Table&) = delete;
+
+    // Every existing index is kept up to date
+    void insert(int i, const string& n, int a) {
+        uint32_t row = (uint32_t)id.size();
+        id.push_back(i);
+        name.push_back(n);
+        age.push_back(a);
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].intIndex) columns[c].intIndex->insert((*columns[c].ints)[row], row);
+            if (columns[c].stringIndex) columns[c].stringIndex->insert((*columns[c].strings)[row], row);
+        }
+    }
+
+    int findColumn(const string& n) const {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].name == n) return (int)c;
+        }
+        return -1;
+    }
+
+    // Index on a column, or nullptr (no such column, wrong type, or no index yet)
+    BPlusTree<int>* intIndex(const string& column) const {
+        int c = findColumn(column);
+        return c < 0 ? nullptr : columns[c].intIndex;
+    }
+
+    BPlusTree<string>* stringIndex(const string& column) const {
+        int c = findColumn(column);
+        return c < 0 ? nullptr : columns[c].stringIndex;
+    }
+
+    // CREATE INDEX: sort (key, row) pairs once, then bulk load
+    template <typename Key>
+    static BPlusTree<Key>* buildIndex(const vector<Key>& column) {
+        vector<typename BPlusTree<Key>::Entry> entries(column.size());
+        for (size_t r = 0; r < column.size(); r++) entries[r] = {column[r], (uint32_t)r};
+        sort(entries.begin(), entries.end());
+        BPlusTree<Key>* tree = new BPlusTree<Key>();
+        tree->bulkLoad(entries);
+        return tree;
+    }
+
+    // Works for any column; rebuilding an existing index replaces it
+    bool createIndex(const string& column) {
+        cout << "CREATE INDEX ON " << tableName << " (" << column << ")" << endl;
+        int c = findColumn(column);
+        if (c < 0) {
+            cout << "Error: table " << tableName << " has no column " << column << endl;
+            return false;
+        }
+        ColumnSlot& slot = columns[c];
+        if (slot.ints) { delete slot.intIndex; slot.intIndex = buildIndex(*slot.ints); }
+        else           { delete slot.stringIndex; slot.stringIndex = buildIndex(*slot.strings); }
+        return true;
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const size_t N = 2000000;
+    const char* first[] = {"Ali", "Sara", "Omar", "Hina", "Bilal", "Ayesha", "Zain", "Fatima"};
+    Table users("users");
+    unsigned seed = 2024;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        users.insert((int)i, string(first[(seed >> 20) % 8]) + to_string((seed >> 8) % 100000), 18 + (int)((seed >> 4) % 60));
+    }
+    cout << "===== " << N << " rows in users =====" << endl;
+
+    auto start = chrono::steady_clock::now();
+    users.createIndex("age");
+    BPlusTree<int>* ageIndex = users.intIndex("age");
+    cout << "  bulk load: " << millisecondsSince(start) << " ms, " << ageIndex->levels()
+         << " levels, " << ageIndex->nodes() << " nodes" << endl;
+    start = chrono::steady_clock::now();
+    users.createIndex("name");
+    BPlusTree<string>* nameIndex = users.stringIndex("name");
+    cout << "  bulk load: " << millisecondsSince(start) << " ms, " << nameIndex->levels() << " levels" << endl;
+    bool unknownRejected = !users.createIndex("salary");
+    cout << "  unknown column rejected: " << (unknownRejected ? "YES" : "NO") << endl;
+
+    cout << "\n===== SELECT COUNT(*), SUM(id) WHERE age > 20 AND age < 30 =====" << endl;
+    start = chrono::steady_clock::now();
+    long long scanCount = 0, scanSum = 0;
+    for (size_t r = 0; r < N; r++) {
+        if (users.age[r] > 20 && users.age[r] < 30) { scanCount++; scanSum += users.id[r]; }
+    }
+    double scanMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    long long idxCount = 0, idxSum = 0;
+    ageIndex->rangeScan(20, false, 30, false, [&](uint32_t r) { idxCount++; idxSum += users.id[r]; return true; });
+    double idxMs = millisecondsSince(start);
+    cout << "Full scan  : " << scanCount << " rows in " << scanMs << " ms" << endl;
+    cout << "Index scan : " << idxCount << " rows in " << idxMs << " ms  "
+         << (scanCount == idxCount && scanSum == idxSum ? "(match)" : "(MISMATCH)") << endl;
+
+    cout << "\n===== Narrow range: WHERE name >= 'Sara500' AND name <= 'Sara501' =====" << endl;
+    start = chrono::steady_clock::now();
+    scanCount = 0;
+    for (size_t r = 0; r < N; r++) {
+        if (users.name[r] >= "Sara500" && users.name[r] <= "Sara501") scanCount++;
+    }
+    scanMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    vector<uint32_t> hits;
+    nameIndex->rangeScan(string("Sara500"), true, string("Sara501"), true, [&](uint32_t r) { hits.push_back(r); return true; });
+    idxMs = millisecondsSince(start);
+    cout << "Full scan  : " << scanCount << " rows in " << scanMs << " ms" << endl;
+    cout << "Index scan : " << hits.size() << " rows in " << idxMs << " ms" << endl;
+    for (size_t k = 0; k < hits.size() && k < 3; k++) {
+        cout << "  " << users.id[hits[k]] << "\t" << users.name[hits[k]] << "\t" << users.age[hits[k]] << endl;
+    }
+
+    cout << "\n===== SELECT * FROM users ORDER BY name LIMIT 5 =====" << endl;
+    start = chrono::steady_clock::now();
+    vector<uint32_t> order(N);
+    for (size_t r = 0; r < N; r++) order[r] = (uint32_t)r;
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return users.name[a] < users.name[b] || (users.name[a] == users.name[b] && a < b);
+    });
+    scanMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    vector<uint32_t> top;
+    nameIndex->scanAll([&](uint32_t r) { top.push_back(r); return top.size() < 5; });
+    idxMs = millisecondsSince(start);
+    for (size_t k = 0; k < top.size(); k++) {
+        cout << "  " << users.id[top[k]] << "\t" << users.name[top[k]] << "\t" << users.age[top[k]] << endl;
+    }
+    cout << "Sort       : " << scanMs << " ms" << endl;
+    cout << "Leaf chain : " << idxMs << " ms  "
+         << (equal(top.begin(), top.end(), order.begin()) ? "(same order)" : "(DIFFERENT)") << endl;
+
+    cout << "\n===== INSERT after CREATE INDEX (node splits) =====" << endl;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < 200000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        users.insert((int)(N + i), string(first[(seed >> 20) % 8]) + to_string((seed >> 8) % 100000), 18 + (int)((seed >> 4) % 60));
+    }
+    cout << "200000 inserts maintaining 2 indexes: " << millisecondsSince(start) << " ms" << endl;
+    users.createIndex("id");
+    long long idHits = 0;
+    users.intIndex("id")->rangeScan((int)N, true, (int)N + 9, true, [&](uint32_t) { idHits++; return true; });
+    cout << "WHERE id BETWEEN " << N << " AND " << N + 9 << " via the new id index: " << idHits << " rows" << endl;
+    cout << "age index : " << ageIndex->size() << " entries, " << ageIndex->levels() << " levels, "
+         << (ageIndex->verify() ? "valid" : "CORRUPT") << endl;
+    cout << "name index: " << nameIndex->size() << " entries, " << nameIndex->levels() << " levels, "
+         << (nameIndex->verify() ? "valid" : "CORRUPT") << endl;
+
+    scanCount = 0;
+    for (size_t r = 0; r < users.age.size(); r++) scanCount += (users.age[r] >= 40 && users.age[r] <= 45);
+    idxCount = 0;
+    ageIndex->rangeScan(40, true, 45, true, [&](uint32_t) { idxCount++; return true; });
+    cout << "WHERE age BETWEEN 40 AND 45: scan " << scanCount << ", index " << idxCount
+         << (scanCount == idxCount ? " (match)" : " (MISMATCH)") << endl;
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. B+-Tree Structure
+       - Inner nodes: separator keys + child pointers (navigation only)
+       - Leaves: all (key, rowId) entries, sorted, linked with 'next'
+       - Every leaf is at the same depth: search cost = height = O(log n)
+
+    2. Cache-Conscious Nodes
+       - alignas(64): every node starts on a cache-line boundary
+       - int keys: 16 x 8-byte entries = 2 adjacent cache lines per level
+       - string keys: 40-byte entries (10 lines), plus a heap read per
+         compare for keys longer than the short-string buffer
+       - High fan-out -> 2M rows need only ~6 levels
+
+    3. Bulk Loading
+       - Sort once, fill leaves completely from left to right
+       - Build each parent level from the smallest key of each child
+       - Much faster than 2M individual inserts, and nodes are 100% full
+
+    4. Range Scan
+       - Descend to the first key >= lo (one root-to-leaf path)
+       - Follow leaf->next until key > hi
+       - Cost: O(log n + output size), independent of table size otherwise
+
+    5. ORDER BY
+       - Leaves are already in key order
+       - ORDER BY ... LIMIT 5 stops after 5 entries: no sort at all
+
+    6. Duplicates
+       - Entry ordered by (key, rowId): equal keys allowed, entries still unique
+
+    7. Index Per Column
+       - Each column slot holds its own tree (nullptr until CREATE INDEX)
+       - createIndex() works on any column; an unknown name is an error
+       - insert() updates every index that exists
+
+    8. Insert With Splits
+       - Full leaf: move upper half to a new leaf, push its first key up
+       - Full inner node: middle separator moves up to the parent
+       - Root split: new root, tree grows by one level at the top
+*/
@@ -0,0 +1,542 @@
+/*
+    12) MVCC SNAPSHOT READS (SELECT never blocks INSERT)
+
+    Explanation:
+    - Spec Table = one vector<Row*>: a long SELECT and an INSERT touching it at
+      the same time need one global lock -> scans stall ingestion and vice versa
+    - MVCC (Multi-Version Concurrency Control):
+      -> a row is a CHAIN of versions, newest first
+      -> each version carries [begin, end) commit timestamps
+      -> UPDATE never overwrites: it appends a new version and closes the old one
+      -> DELETE only closes the newest version (end = commit timestamp)
+    - Reader: snapshot = current commit timestamp (one atomic load, no lock)
+      -> sees exactly the versions with begin <= snapshot < end
+      -> writers that commit later are invisible, the scan stays consistent
+    - Writers: serialized among themselves, committed with ONE atomic store
+      of the new timestamp (all rows of a write become visible together)
+    - Garbage collector (background thread): versions that ended before the
+      oldest active snapshot can never be read again -> freed
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// ===== VERSION =====
+// values are written once before the version is published, then read-only
+struct Version {
+    atomic<uint64_t> begin;
+    atomic<uint64_t> end;
+    atomic<Version*> older;
+    vector<string> values;
+
+    Version(uint64_t b, const vector<string>& v, Version* prev)
+        : begin(b), end(INFINITE_TS), older(prev), values(v) {}
+
+    bool visibleAt(uint64_t snapshot) const {
+        return begin.load(memory_order_acquire) <= snapshot && snapshot < end.load(memory_order_acquire);
+    }
+
+    static const uint64_t INFINITE_TS = UINT64_MAX;
+};
+
+const uint64_t Version::INFINITE_TS;
+
+// ===== MVCC TABLE =====
+class MvccTable {
+private:
+    // Row slots live in fixed segments that never move, so readers can index
+    // them while the writer appends (a vector would reallocate under them)
+    static const size_t SEGMENT_SIZE = 4096;
+    static const size_t MAX_SEGMENTS = 4096;
+    static const int MAX_READERS = 64;
+    static const uint64_t NO_SNAPSHOT = UINT64_MAX;
+
+    struct Segment {
+        atomic<Version*> heads[SEGMENT_SIZE];
+
+        Segment() {
+            for (size_t i = 0; i < SEGMENT_SIZE; i++) heads[i].store(nullptr, memory_order_relaxed);
+        }
+    };
+
+    string tableName;
+    vector<string> columns;
+    atomic<Segment*> segments[MAX_SEGMENTS];
+    atomic<size_t> rowCount;
+    atomic<uint64_t> commitTs;                  // Last committed timestamp
+
+    // Writer side
+    mutex writerMutex;
+    uint64_t pendingTs;                         // Timestamp of the open write
+
+    // Snapshot registry: one slot per active reader, NO_SNAPSHOT if free
+    atomic<uint64_t> readerSlots[MAX_READERS];
+
+    // Garbage collection
+    mutex gcMutex;
+    vector<uint32_t> gcCandidates;              // Rows that have old versions
+    thread gcThread;
+    atomic<bool> gcRunning;
+    atomic<size_t> liveVersions;
+    atomic<size_t> reclaimedVersions;
+
+    atomic<Version*>& head(uint32_t row) {
+        return segments[row / SEGMENT_SIZE].load(memory_order_acquire)->heads[row % SEGMENT_SIZE];
+    }
+
+    void deleteChain(Version* v) {
+        while (v) {
+            Version* next = v->older.load(memory_order_relaxed);
+            delete v;
+            v = next;
+        }
+    }
+
+    void gcLoop() {
+        while (gcRunning.load()) {
+            collectGarbage();
+            this_thread::sleep_for(chrono::milliseconds(5));
+        }
+    }
+
+public:
+    MvccTable(string name) : tableName(name), rowCount(0), commitTs(1), pendingTs(0),
+                             gcRunning(false), liveVersions(0), reclaimedVersions(0) {
+        for (size_t i = 0; i < MAX_SEGMENTS; i++) segments[i].store(nullptr);
+        for (int i = 0; i < MAX_READERS; i++) readerSlots[i].store(NO_SNAPSHOT);
+    }
+
+    ~MvccTable() {
+        stopGarbageCollector();
+        size_t rows = rowCount.load();
+        for (size_t r = 0; r < rows; r++) deleteChain(head((uint32_t)r).load());
+        for (size_t i = 0; i < MAX_SEGMENTS; i++) delete segments[i].load();
+    }
+
+    MvccTable(const MvccTable&) = delete;
+    MvccTable& operator=(const MvccTable&) = delete;
+
+    void addColumn(const string& name) {
+        columns.push_back(name);
+    }
+
+    // ===== READERS (lock-free) =====
+    class Snapshot {
+    private:
+        MvccTable& table;
+        int slot;
+
+    public:
+        uint64_t ts;
+
+        // Publish the snapshot in a free slot. Re-check the clock after
+        // publishing: if it moved, the GC may have missed us -> retry.
+        Snapshot(MvccTable& t) : table(t), slot(-1), ts(0) {
+            while (slot < 0) {
+                for (int i = 0; i < MAX_READERS && slot < 0; i++) {
+                    uint64_t expected = NO_SNAPSHOT;
+                    ts = table.commitTs.load();
+                    if (table.readerSlots[i].compare_exchange_strong(expected, ts)) slot = i;
+                }
+            }
+            uint64_t now;
+            while ((now = table.commitTs.load()) != ts) {
+                ts = now;
+                table.readerSlots[slot].store(ts);
+            }
+        }
+
+        ~Snapshot() {
+            table.readerSlots[slot].store(NO_SNAPSHOT);
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+    };
+
+    // Newest version visible at the snapshot, or nullptr (not inserted yet / deleted)
+    const Version* read(const Snapshot& snap, uint32_t row) {
+        if (row >= rowCount.load(memory_order_acquire)) return nullptr;
+        Version* v = head(row).load(memory_order_acquire);
+        // Stop at the first version that began at or before the snapshot:
+        // anything older ended before it and is invisible (possibly freed)
+        while (v && v->begin.load(memory_order_acquire) > snap.ts) v = v->older.load(memory_order_acquire);
+        if (v && v->visibleAt(snap.ts)) return v;
+        return nullptr;
+    }
+
+    // Full table scan at one snapshot
+    template <typename Visit>
+    void scan(const Snapshot& snap, Visit visit) {
+        size_t rows = rowCount.load(memory_order_acquire);
+        for (size_t r = 0; r < rows; r++) {
+            const Version* v = read(snap, (uint32_t)r);
+            if (v) visit((uint32_t)r, v->values);
+        }
+    }
+
+    // ===== WRITERS =====
+    // beginWrite() ... insert/update/remove ... commit()
+    // Versions are stamped with pendingTs, which stays invisible until commit
+    void beginWrite() {
+        writerMutex.lock();
+        pendingTs = commitTs.load() + 1;
+    }
+
+    // Writer's own view: newest version, including its uncommitted changes
+    const Version* latest(uint32_t row) {
+        if (row >= rowCount.load(memory_order_relaxed)) return nullptr;
+        Version* v = head(row).load(memory_order_relaxed);
+        return v->end.load(memory_order_relaxed) == Version::INFINITE_TS ? v : nullptr;
+    }
+
+    uint32_t insert(const vector<string>& values) {
+        size_t row = rowCount.load(memory_order_relaxed);
+        size_t seg = row / SEGMENT_SIZE;
+        if (seg >= MAX_SEGMENTS) {
+            cout << "Error: " << tableName << " is full" << endl;
+            return UINT32_MAX;
+        }
+        if (!segments[seg].load(memory_order_relaxed)) segments[seg].store(new Segment(), memory_order_release);
+        head((uint32_t)row).store(new Version(pendingTs, values, nullptr), memory_order_release);
+        rowCount.store(row + 1, memory_order_release);
+        liveVersions++;
+        return (uint32_t)row;
+    }
+
+    bool update(uint32_t row, const vector<string>& values) {
+        if (row >= rowCount.load(memory_order_relaxed)) return false;
+        Version* old = head(row).load(memory_order_relaxed);
+        if (old->end.load(memory_order_relaxed) != Version::INFINITE_TS) return false;   // Deleted
+        head(row).store(new Version(pendingTs, values, old), memory_order_release);
+        old->end.store(pendingTs, memory_order_release);
+        liveVersions++;
+        lock_guard<mutex> lock(gcMutex);
+        gcCandidates.push_back(row);
+        return true;
+    }
+
+    bool remove(uint32_t row) {
+        if (row >= rowCount.load(memory_order_relaxed)) return false;
+        Version* old = head(row).load(memory_order_relaxed);
+        if (old->end.load(memory_order_relaxed) != Version::INFINITE_TS) return false;
+        old->end.store(pendingTs, memory_order_release);
+        return true;
+    }
+
+    // One atomic store makes every version of this write visible at once
+    void commit() {
+        commitTs.store(pendingTs, memory_order_release);
+        writerMutex.unlock();
+    }
+
+    // ===== GARBAGE COLLECTION =====
+    // Oldest timestamp any reader can still use (read clock BEFORE the slots)
+    uint64_t oldestActiveSnapshot() {
+        uint64_t oldest = commitTs.load();
+        for (int i = 0; i < MAX_READERS; i++) {
+            uint64_t s = readerSlots[i].load();
+            if (s < oldest) oldest = s;
+        }
+        return oldest;
+    }
+
+    // Cut each chain below the first version that began at or before the
+    // oldest snapshot. Readers stop there too, so nobody walks past the cut.
+    // A deleted row keeps its last version as a tombstone (slot stays valid).
+    void collectGarbage() {
+        vector<uint32_t> rows;
+        {
+            lock_guard<mutex> lock(gcMutex);
+            rows.swap(gcCandidates);
+        }
+        uint64_t oldest = oldestActiveSnapshot();
+        vector<uint32_t> retry;
+        for (size_t i = 0; i < rows.size(); i++) {
+            Version* v = head(rows[i]).load(memory_order_acquire);
+            while (v && v->begin.load(memory_order_acquire) > oldest) v = v->older.load(memory_order_acquire);
+            if (!v) {
+                retry.push_back(rows[i]);       // Still needed by an old snapshot
+                continue;
+            }
+            Version* garbage = v->older.exchange(nullptr, memory_order_acq_rel);
+            size_t freed = 0;
+            while (garbage) {
+                Version* next = garbage->older.load(memory_order_relaxed);
+                delete garbage;
+                garbage = next;
+                freed++;
+            }
+            liveVersions -= freed;
+            reclaimedVersions += freed;
+        }
+        if (!retry.empty()) {
+            lock_guard<mutex> lock(gcMutex);
+            gcCandidates.insert(gcCandidates.end(), retry.begin(), retry.end());
+        }
+    }
+
+    void startGarbageCollector() {
+        gcRunning.store(true);
+        gcThread = thread(&MvccTable::gcLoop, this);
+    }
+
+    void stopGarbageCollector() {
+        if (!gcRunning.exchange(false)) return;
+        gcThread.join();
+    }
+
+    size_t size() const { return rowCount.load(); }
+    size_t versions() const { return liveVersions.load(); }
+    size_t reclaimed() const { return reclaimedVersions.load(); }
+    uint64_t lastCommit() const { return commitTs.load(); }
+};
+
+// ===== BASELINE: spec-style vector<Row*> behind one global lock =====
+class Row {
+public:
+    vector<string> values;
+};
+
+class LockedTable {
+public:
+    vector<Row*> rows;
+    mutex tableLock;
+
+    ~LockedTable() {
+        for (size_t i = 0; i < rows.size(); i++) delete rows[i];
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+struct RunStats {
+    long long commits = 0;
+    long long scans = 0;
+    double worstWaitMs = 0;                     // Writer blocked before it could write
+    double totalWaitMs = 0;
+    bool consistent = true;
+};
+
+// Writer: move money between two accounts per commit (total stays constant)
+// and append a zero-balance account every 16 commits. Readers: full scans
+// that must always see the same total.
+const int READERS = 2;
+const double RUN_MS = 1000;
+
+RunStats runMvcc(int accounts, long long expectedTotal) {
+    MvccTable table("accounts");
+    table.addColumn("name");
+    table.addColumn("balance");
+    table.beginWrite();
+    for (int i = 0; i < accounts; i++) table.insert({"acct" + to_string(i), "1000"});
+    table.commit();
+    table.startGarbageCollector();
+
+    RunStats stats;
+    atomic<bool> running(true);
+    atomic<long long> scans(0);
+    atomic<bool> consistent(true);
+    vector<thread> readers;
+    for (int t = 0; t < READERS; t++) {
+        readers.push_back(thread([&]() {
+            while (running.load()) {
+                MvccTable::Snapshot snap(table);
+                long long total = 0;
+                table.scan(snap, [&](uint32_t, const vector<string>& v) { total += stoll(v[1]); });
+                if (total != expectedTotal) consistent.store(false);
+                scans++;
+            }
+        }));
+    }
+
+    auto start = chrono::steady_clock::now();
+    unsigned seed = 7;
+    while (millisecondsSince(start) < RUN_MS) {
+        auto commitStart = chrono::steady_clock::now();
+        seed = seed * 1103515245u + 12345u;
+        uint32_t from = (seed >> 8) % accounts;
+        uint32_t to = (seed >> 4) % accounts;
+        table.beginWrite();
+        double waited = millisecondsSince(commitStart);
+        if (from != to) {
+            long long a = stoll(table.latest(from)->values[1]);
+            long long b = stoll(table.latest(to)->values[1]);
+            table.update(from, {"acct" + to_string(from), to_string(a - 5)});
+            table.update(to, {"acct" + to_string(to), to_string(b + 5)});
+        }
+        if (stats.commits % 16 == 0) table.insert({"new" + to_string(stats.commits), "0"});
+        table.commit();
+        stats.commits++;
+        if (waited > stats.worstWaitMs) stats.worstWaitMs = waited;
+        stats.totalWaitMs += waited;
+    }
+    running.store(false);
+    for (size_t t = 0; t < readers.size(); t++) readers[t].join();
+    table.stopGarbageCollector();
+    table.collectGarbage();
+
+    stats.scans = scans.load();
+    stats.consistent = consistent.load();
+    cout << "  rows " << table.size() << ", live versions " << table.versions()
+         << ", reclaimed by GC " << table.reclaimed() << endl;
+    return stats;
+}
+
+RunStats runLocked(int accounts, long long expectedTotal) {
+    LockedTable table;
+    for (int i = 0; i < accounts; i++) {
+        Row* r = new Row();
+        r->values = {"acct" + to_string(i), "1000"};
+        table.rows.push_back(r);
+    }
+
+    RunStats stats;
+    atomic<bool> running(true);
+    atomic<long long> scans(0);
+    atomic<bool> consistent(true);
+    vector<thread> readers;
+    for (int t = 0; t < READERS; t++) {
+        readers.push_back(thread([&]() {
+            while (running.load()) {
+                lock_guard<mutex> lock(table.tableLock);      // Whole scan holds the lock
+                long long total = 0;
+                for (size_t r = 0; r < table.rows.size(); r++) total += stoll(table.rows[r]->values[1]);
+                if (total != expectedTotal) consistent.store(false);
+                scans++;
+            }
+        }));
+    }
+
+    auto start = chrono::steady_clock::now();
+    unsigned seed = 7;
+    while (millisecondsSince(start) < RUN_MS) {
+        auto commitStart = chrono::steady_clock::now();
+        double waited = 0;
+        seed = seed * 1103515245u + 12345u;
+        uint32_t from = (seed >> 8) % accounts;
+        uint32_t to = (seed >> 4) % accounts;
+        {
+            lock_guard<mutex> lock(table.tableLock);
+            waited = millisecondsSince(commitStart);
+            if (from != to) {
+                table.rows[from]->values[1] = to_string(stoll(table.rows[from]->values[1]) - 5);
+                table.rows[to]->values[1] = to_string(stoll(table.rows[to]->values[1]) + 5);
+            }
+            if (stats.commits % 16 == 0) {
+                Row* r = new Row();
+                r->values = {"new" + to_string(stats.commits), "0"};
+                table.rows.push_back(r);
+            }
+        }
+        stats.commits++;
+        if (waited > stats.worstWaitMs) stats.worstWaitMs = waited;
+        stats.totalWaitMs += waited;
+    }
+    running.store(false);
+    for (size_t t = 0; t < readers.size(); t++) readers[t].join();
+
+    stats.scans = scans.load();
+    stats.consistent = consistent.load();
+    cout << "  rows " << table.rows.size() << endl;
+    return stats;
+}
+
+void printStats(const string& label, const RunStats& s) {
+    cout << label << ": " << s.commits << " commits, " << s.scans << " full scans, writer blocked "
+         << s.totalWaitMs << " ms total (worst " << s.worstWaitMs << " ms), every scan consistent: "
+         << (s.consistent ? "YES" : "NO") << endl;
+}
+
+int main() {
+    cout << "===== SNAPSHOT VISIBILITY =====" << endl;
+    {
+        MvccTable users("users");
+        users.addColumn("name");
+        users.addColumn("city");
+        users.beginWrite();
+        users.insert({"Ali", "Lahore"});
+        users.insert({"Sara", "Karachi"});
+        users.commit();
+
+        MvccTable::Snapshot before(users);
+
+        users.beginWrite();
+        users.update(0, {"Ali", "Islamabad"});
+        users.remove(1);
+        users.insert({"Omar", "Multan"});
+        users.commit();
+
+        MvccTable::Snapshot after(users);
+
+        auto print = [&](const char* label, const MvccTable::Snapshot& snap) {
+            cout << label << " (ts " << snap.ts << "):" << endl;
+            users.scan(snap, [](uint32_t row, const vector<string>& v) {
+                cout << "  row " << row << ": " << v[0] << ", " << v[1] << endl;
+            });
+        };
+        print("Old snapshot", before);
+        print("New snapshot", after);
+
+        users.collectGarbage();
+        cout << "GC while old snapshot is open: " << users.reclaimed() << " versions reclaimed" << endl;
+    }
+
+    const int ACCOUNTS = 20000;
+    const long long TOTAL = ACCOUNTS * 1000LL;
+    cout << "\n===== LONG SCANS DURING INGESTION (" << READERS << " readers, 1 writer, "
+         << RUN_MS << " ms) =====" << endl;
+    cout << "Global lock:" << endl;
+    RunStats locked = runLocked(ACCOUNTS, TOTAL);
+    cout << "MVCC:" << endl;
+    RunStats mvcc = runMvcc(ACCOUNTS, TOTAL);
+    printStats("Global lock", locked);
+    printStats("MVCC       ", mvcc);
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Versions Instead of Overwrites
+       - Row = chain of versions, newest first (head pointer per row)
+       - Version visible at snapshot S  <=>  begin <= S < end
+       - UPDATE: new head + old.end = commit ts, DELETE: head.end = commit ts
+
+    2. Snapshot Reads Without Locks
+       - Snapshot = one atomic load of the commit clock
+       - Readers never take writerMutex: writers never wait for a scan
+       - The scan sees the table exactly as of its snapshot (no torn transfers)
+
+    3. Atomic Commit
+       - All versions of a write are stamped with pendingTs = clock + 1
+       - Invisible until commit() stores pendingTs into the clock
+       - One store publishes every row change of the write at once
+
+    4. Stable Row Slots
+       - Segments of 4096 row heads that never move
+       - Writer fills the slot, THEN publishes rowCount (release/acquire)
+
+    5. Garbage Collection
+       - Each reader publishes its snapshot in a slot
+       - oldest = min(active snapshots, clock)
+       - In each chain, cut below the first version with begin <= oldest:
+         every reader stops at or above it, so nobody reaches freed versions
+       - Runs in a background thread; rows still pinned by old snapshots retry
+
+    6. Trade-offs
+       - Extra memory for old versions until GC catches up
+       - Writers are still serialized among themselves (single commit clock)
+       - Deleted rows keep a tombstone version; slots are not reused here
+       - "writer blocked" counts time waiting for a lock; on a single core the
+         OS still time-slices the threads, so compare it on a multi-core machine
+*/
@@ -0,0 +1,384 @@
+/*
+    1) COLUMNAR STORAGE ENGINE (Column-Major Table)
+
+    Explanation:
+    - Row-major model (dbms.md): vector<Row*>, every Row owns vector<string>
+      -> one heap pointer per row, one string per value, ints stored as text
+    - Column-major model: each column owns ONE contiguous buffer
+      -> int column:    vector<int>                 (4 bytes per value)
+      -> string column: vector<uint32_t> offsets + vector<char> bytes
+    - Same public API: Column / Row / Table, INSERT takes a Row, SELECT prints Rows
+    - Scans walk contiguous memory -> CPU prefetcher + cache lines do the work
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+using namespace std;
+
+// ===== CONSTRAINT FLAGS (same bits as dbms.md) =====
+const unsigned int PRIMARY_KEY = 1;
+const unsigned int NOT_NULL    = 2;
+const unsigned int UNIQUE      = 4;
+
+// ===== SCHEMA: Column (unchanged from the spec) =====
+class Column {
+public:
+    string name;
+    string type;              // "int" or "string"
+    unsigned int constraints;
+
+    Column(string n, string t, unsigned int c) : name(n), type(t), constraints(c) {}
+
+    bool isInt() const {
+        return type == "int";
+    }
+};
+
+// ===== FACADE: Row (unchanged from the spec) =====
+// Used only at the edges: INSERT input and SELECT output.
+// Rows are NOT the storage format any more.
+class Row {
+public:
+    vector<string> values;
+};
+
+// ===== STORAGE: ColumnData =====
+// One object per column. Only one of the two layouts is used.
+class ColumnData {
+public:
+    // Layout 1: int column -> typed contiguous buffer
+    vector<int> ints;
+
+    // Layout 2: string column -> offsets + bytes
+    // value i lives in bytes[offsets[i] .. offsets[i+1])
+    // offsets always has (rowCount + 1) entries, offsets[0] = 0
+    vector<uint32_t> offsets;
+    vector<char> bytes;
+
+    // NULL bitmap: bit r set = row r is NULL (its slot above holds 0 / "").
+    // Grown only when a NULL arrives, so NOT NULL columns never pay for it.
+    vector<uint64_t> nullBits;
+
+    ColumnData() {
+        offsets.push_back(0);
+    }
+
+    void markNull(size_t row) {
+        if (nullBits.size() <= row / 64) nullBits.resize(row / 64 + 1, 0);
+        nullBits[row / 64] |= 1ULL << (row % 64);
+    }
+
+    bool isNull(size_t row) const {
+        return row / 64 < nullBits.size() && ((nullBits[row / 64] >> (row % 64)) & 1);
+    }
+
+    void appendInt(int v) {
+        ints.push_back(v);
+    }
+
+    void appendString(const string& s) {
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        offsets.push_back((uint32_t)bytes.size());
+    }
+
+    // Pointer + length view into the byte buffer (no copy)
+    const char* stringData(size_t row) const {
+        return bytes.data() + offsets[row];
+    }
+
+    size_t stringLength(size_t row) const {
+        return offsets[row + 1] - offsets[row];
+    }
+
+    size_t memoryUsage() const {
+        return ints.capacity() * sizeof(int)
+             + offsets.capacity() * sizeof(uint32_t)
+             + bytes.capacity()
+             + nullBits.capacity() * sizeof(uint64_t);
+    }
+};
+
+// ===== TABLE: column-major =====
+class Table {
+private:
+    string tableName;
+    vector<Column> columns;
+    vector<ColumnData> data;   // data[c] holds every value of columns[c]
+    size_t rowCount;
+
+    // Parse "20" -> 20 once, at insert time (never again during scans)
+    static bool parseInt(const string& s, int& out) {
+        if (s.empty()) return false;
+        char* end = nullptr;
+        errno = 0;
+        long v = strtol(s.c_str(), &end, 10);
+        if (*end != '\0') return false;
+        if (errno == ERANGE || v < INT_MIN || v > INT_MAX) return false;   // Would not fit: reject, never wrap
+        out = (int)v;
+        return true;
+    }
+
+public:
+    Table(string name) : tableName(name), rowCount(0) {}
+
+    // No destructor work needed: vectors free their own buffers.
+    // Compare with vector<Row*>: one delete per row.
+
+    void addColumn(const Column& col) {
+        columns.push_back(col);
+        data.push_back(ColumnData());
+    }
+
+    // Reserve space for n rows (avoids repeated reallocation on bulk load)
+    void reserve(size_t n, size_t avgStringLength = 8) {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].isInt()) {
+                data[c].ints.reserve(n);
+            } else {
+                data[c].offsets.reserve(n + 1);
+                data[c].bytes.reserve(n * avgStringLength);
+            }
+        }
+    }
+
+    // INSERT: validates the Row, then scatters values into column buffers
+    bool insert(const Row& row) {
+        if (row.values.size() != columns.size()) {
+            cout << "Error: Expected " << columns.size() << " values!" << endl;
+            return false;
+        }
+
+        // Validate everything BEFORE touching storage (all-or-nothing insert)
+        vector<int> parsed(columns.size(), 0);
+        for (size_t c = 0; c < columns.size(); c++) {
+            const string& v = row.values[c];
+            if ((columns[c].constraints & NOT_NULL) && v.empty()) {
+                cout << "Error: " << columns[c].name << " cannot be NULL!" << endl;
+                return false;
+            }
+            if (v.empty()) continue;      // NULL in a nullable column: nothing to parse
+            if (columns[c].isInt() && !parseInt(v, parsed[c])) {
+                cout << "Error: " << columns[c].name << " must be int!" << endl;
+                return false;
+            }
+        }
+
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].isInt()) data[c].appendInt(parsed[c]);     // NULL -> 0, so SUM is unaffected
+            else                    data[c].appendString(row.values[c]);
+            if (row.values[c].empty()) data[c].markNull(rowCount);
+        }
+        rowCount++;
+        return true;
+    }
+
+    // Rebuild a Row on demand (used by SELECT output only); NULL -> ""
+    Row getRow(size_t r) const {
+        Row row;
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (data[c].isNull(r)) {
+                row.values.push_back("");
+            } else if (columns[c].isInt()) {
+                row.values.push_back(to_string(data[c].ints[r]));
+            } else {
+                row.values.push_back(string(data[c].stringData(r), data[c].stringLength(r)));
+            }
+        }
+        return row;
+    }
+
+    // SELECT * FROM table
+    void selectAll() const {
+        for (size_t c = 0; c < columns.size(); c++) {
+            cout << columns[c].name << "\t";
+        }
+        cout << endl;
+        for (size_t r = 0; r < rowCount; r++) {
+            Row row = getRow(r);
+            for (size_t c = 0; c < row.values.size(); c++) {
+                cout << (data[c].isNull(r) ? "NULL" : row.values[c]) << "\t";
+            }
+            cout << endl;
+        }
+    }
+
+    // Typed access for scans (no Row, no string parsing)
+    int findColumn(const string& name) const {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].name == name) return (int)c;
+        }
+        return -1;
+    }
+
+    const int* intColumn(int c) const {
+        return data[c].ints.data();
+    }
+
+    const ColumnData& columnData(int c) const {
+        return data[c];
+    }
+
+    size_t size() const {
+        return rowCount;
+    }
+
+    size_t memoryUsage() const {
+        size_t total = sizeof(Table);
+        for (size_t c = 0; c < data.size(); c++) total += data[c].memoryUsage();
+        return total;
+    }
+};
+
+// ===== SCAN KERNELS =====
+// Tight loop over a contiguous int buffer: compiler can vectorize this.
+long long sumIntColumn(const int* values, size_t n) {
+    long long sum = 0;
+    for (size_t i = 0; i < n; i++) sum += values[i];
+    return sum;
+}
+
+// Same query on the row-major model: pointer chase + string parse per row
+long long sumRowModel(const vector<Row*>& rows, size_t col) {
+    long long sum = 0;
+    for (size_t i = 0; i < rows.size(); i++) sum += atoi(rows[i]->values[col].c_str());
+    return sum;
+}
+
+// Approximate heap footprint of the vector<Row*> model
+// (16 bytes of allocator overhead per malloc is a typical glibc figure)
+size_t rowModelMemory(const vector<Row*>& rows) {
+    const size_t MALLOC_OVERHEAD = 16;
+    size_t total = rows.capacity() * sizeof(Row*);
+    for (size_t i = 0; i < rows.size(); i++) {
+        const Row* r = rows[i];
+        total += sizeof(Row) + MALLOC_OVERHEAD;                              // new Row
+        total += r->values.capacity() * sizeof(string) + MALLOC_OVERHEAD;    // values buffer
+        for (size_t c = 0; c < r->values.size(); c++) {
+            if (r->values[c].capacity() > 15) {                              // beyond SSO
+                total += r->values[c].capacity() + 1 + MALLOC_OVERHEAD;
+            }
+        }
+    }
+    return total;
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== CREATE TABLE users =====" << endl;
+    Table users("users");
+    users.addColumn(Column("id", "int", PRIMARY_KEY | NOT_NULL));
+    users.addColumn(Column("name", "string", NOT_NULL));
+    users.addColumn(Column("age", "int", 0));
+    cout << "Table created successfully." << endl;
+
+    cout << "\n===== INSERT (same Row API as the spec) =====" << endl;
+    Row r1; r1.values = {"1", "Ali", "20"};
+    Row r2; r2.values = {"2", "Sara", "21"};
+    Row bad; bad.values = {"3", "Omar", "twenty"};
+    if (users.insert(r1)) cout << "Record inserted." << endl;
+    if (users.insert(r2)) cout << "Record inserted." << endl;
+    users.insert(bad);     // Rejected: age is not an int
+    Row noAge; noAge.values = {"4", "Hina", ""};
+    if (users.insert(noAge)) cout << "Record inserted (age is NULL)." << endl;     // age is nullable
+    Row huge; huge.values = {"99999999999", "Omar", "22"};
+    users.insert(huge);    // Rejected: id does not fit in int (no silent wrap-around)
+
+    cout << "\n===== SELECT * FROM users =====" << endl;
+    users.selectAll();
+
+    cout << "\n===== BULK LOAD: column store vs vector<Row*> =====" << endl;
+    const size_t N = 1000000;
+    const char* names[] = {"Ali", "Sara", "Omar", "Hina", "Bilal", "Ayesha"};
+
+    Table big("big_users");
+    big.addColumn(Column("id", "int", PRIMARY_KEY | NOT_NULL));
+    big.addColumn(Column("name", "string", NOT_NULL));
+    big.addColumn(Column("age", "int", 0));
+    big.reserve(N, 5);
+
+    vector<Row*> rowModel;
+    rowModel.reserve(N);
+
+    Row row;
+    row.values.resize(3);
+    for (size_t i = 0; i < N; i++) {
+        row.values[0] = to_string(i + 1);
+        row.values[1] = names[i % 6];
+        row.values[2] = to_string(18 + (int)(i % 50));
+        big.insert(row);
+        rowModel.push_back(new Row(row));
+    }
+
+    size_t columnBytes = big.memoryUsage();
+    size_t rowBytes = rowModelMemory(rowModel);
+    cout << "Rows: " << N << endl;
+    cout << "vector<Row*> memory : " << rowBytes / (1024 * 1024) << " MB ("
+         << rowBytes / N << " bytes/row)" << endl;
+    cout << "Column store memory : " << columnBytes / (1024 * 1024) << " MB ("
+         << columnBytes / N << " bytes/row)" << endl;
+    cout << "Reduction           : " << (double)rowBytes / columnBytes << "x" << endl;
+
+    cout << "\n===== SCAN: SUM(age) =====" << endl;
+    int ageCol = big.findColumn("age");
+
+    auto start = chrono::steady_clock::now();
+    long long s1 = sumRowModel(rowModel, ageCol);
+    double rowMs = millisecondsSince(start);
+
+    start = chrono::steady_clock::now();
+    long long s2 = sumIntColumn(big.intColumn(ageCol), big.size());
+    double colMs = millisecondsSince(start);
+
+    double gbPerSec = (big.size() * sizeof(int)) / (colMs / 1000.0) / 1e9;
+    cout << "Row model    : " << s1 << " in " << rowMs << " ms" << endl;
+    cout << "Column store : " << s2 << " in " << colMs << " ms ("
+         << gbPerSec << " GB/s)" << endl;
+
+    // Free the row model (the column store needs no manual cleanup)
+    for (size_t i = 0; i < rowModel.size(); i++) delete rowModel[i];
+    rowModel.clear();
+
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Row-Major vs Column-Major
+       - Row-major: all values of ONE row are stored together
+       - Column-major: all values of ONE column are stored together
+       - SELECT SUM(age) only needs "age" -> column store reads only that buffer
+
+    2. Typed Int Buffers
+       - "20" is parsed once at INSERT, stored as a 4-byte int
+       - Scans never call atoi() again
+       - Contiguous ints fit 16 per 64-byte cache line
+
+    3. Offsets + Bytes for Strings
+       - All characters of a column live in one vector<char>
+       - offsets[i]..offsets[i+1] marks value i
+       - No per-value heap allocation, no std::string header (32 bytes) per value
+
+    4. Memory Savings
+       - vector<Row*>: pointer + Row + vector header + 3 string headers + malloc overhead
+       - Column store: 4 + 4 + (4 + name length) + 4 bytes per row
+       - Typically well over 3x smaller for small rows
+
+    5. NULL Bitmap
+       - "" in a nullable column is NULL: the int check is skipped
+       - One bit per row marks it; the int slot holds 0 (SUM unchanged)
+       - Bitmap allocated only once a column sees its first NULL
+
+    6. API Stays the Same
+       - Column describes schema, Row is the INSERT/SELECT format
+       - Only Table's internals changed (encapsulation pays off)
+*/
@@ -0,0 +1,497 @@
+/*
+    2) HASH INDEX FOR PRIMARY KEY / UNIQUE CONSTRAINTS
+
+    Explanation:
+    - Spec: "Prevent duplicate primary keys" without STL map/set
+    - Linear check: scan every existing row on each INSERT -> O(n) per insert, O(n^2) bulk load
+    - Hash index: hash(value) -> slot in a flat array -> O(1) average per insert
+    - Open addressing: no linked lists, collisions probe the NEXT slot (linear probing)
+    - One index per column with PRIMARY_KEY (1) or UNIQUE (4) bit set
+    - Same index answers point lookups: SELECT * FROM users WHERE id = 42
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+using namespace std;
+
+// ===== CONSTRAINT FLAGS (same bits as dbms.md) =====
+const unsigned int PRIMARY_KEY = 1;
+const unsigned int NOT_NULL    = 2;
+const unsigned int UNIQUE      = 4;
+
+class Column {
+public:
+    string name;
+    string type;
+    unsigned int constraints;
+
+    Column(string n, string t, unsigned int c) : name(n), type(t), constraints(c) {}
+
+    bool isInt() const {
+        return type == "int";
+    }
+
+    // Bitwise AND: does this column need an index?
+    bool needsIndex() const {
+        return (constraints & (PRIMARY_KEY | UNIQUE)) != 0;
+    }
+};
+
+class Row {
+public:
+    vector<string> values;
+};
+
+// ===== COLUMN STORAGE (column-major, see 1_columnar_storage.cpp) =====
+class ColumnData {
+public:
+    vector<int> ints;
+    vector<uint32_t> offsets;
+    vector<char> bytes;
+    vector<uint64_t> nullBits;    // Bit r set = row r is NULL (grown on the first NULL)
+
+    ColumnData() {
+        offsets.push_back(0);
+    }
+
+    void markNull(size_t row) {
+        if (nullBits.size() <= row / 64) nullBits.resize(row / 64 + 1, 0);
+        nullBits[row / 64] |= 1ULL << (row % 64);
+    }
+
+    bool isNull(size_t row) const {
+        return row / 64 < nullBits.size() && ((nullBits[row / 64] >> (row % 64)) & 1);
+    }
+
+    const char* stringData(size_t row) const {
+        return bytes.data() + offsets[row];
+    }
+
+    size_t stringLength(size_t row) const {
+        return offsets[row + 1] - offsets[row];
+    }
+};
+
+// ===== HASH FUNCTIONS =====
+// Integer mixer (splitmix64 finalizer): spreads sequential ids over all slots
+uint64_t hashInt(int value) {
+    uint64_t x = (uint64_t)(uint32_t)value;
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// FNV-1a for strings: one XOR + one multiply per byte
+uint64_t hashBytes(const char* p, size_t len) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// ===== OPEN-ADDRESSING HASH INDEX =====
+// Each slot stores (hash, rowId). Keys themselves stay in the column,
+// so the index costs 12 bytes per slot whatever the column type is.
+class HashIndex {
+private:
+    static const uint32_t EMPTY = 0xFFFFFFFFu;
+
+    vector<uint64_t> hashes;
+    vector<uint32_t> rowIds;     // EMPTY marks a free slot
+    size_t mask;                 // capacity - 1 (capacity is a power of two)
+    size_t count;
+
+    const ColumnData* column;
+    bool intKeys;
+
+    // Does row 'r' hold the same key as (intKey) or (strKey, strLen)?
+    bool keyEquals(uint32_t r, int intKey, const char* strKey, size_t strLen) const {
+        if (intKeys) return column->ints[r] == intKey;
+        return column->stringLength(r) == strLen &&
+               memcmp(column->stringData(r), strKey, strLen) == 0;
+    }
+
+    // Double capacity and re-insert all entries (keeps load factor <= 0.5)
+    void grow() {
+        vector<uint64_t> oldHashes;
+        vector<uint32_t> oldRows;
+        oldHashes.swap(hashes);
+        oldRows.swap(rowIds);
+
+        size_t capacity = (mask + 1) * 2;
+        hashes.assign(capacity, 0);
+        rowIds.assign(capacity, EMPTY);
+        mask = capacity - 1;
+
+        for (size_t i = 0; i < oldRows.size(); i++) {
+            if (oldRows[i] == EMPTY) continue;
+            size_t slot = oldHashes[i] & mask;
+            while (rowIds[slot] != EMPTY) slot = (slot + 1) & mask;
+            hashes[slot] = oldHashes[i];
+            rowIds[slot] = oldRows[i];
+        }
+    }
+
+    // Returns slot of the matching key, or the EMPTY slot where it would go
+    size_t probe(uint64_t h, int intKey, const char* strKey, size_t strLen) const {
+        size_t slot = h & mask;
+        while (rowIds[slot] != EMPTY) {
+            if (hashes[slot] == h && keyEquals(rowIds[slot], intKey, strKey, strLen)) {
+                return slot;
+            }
+            slot = (slot + 1) & mask;   // Linear probing: try the next slot
+        }
+        return slot;
+    }
+
+public:
+    HashIndex(const ColumnData* col, bool isInt)
+        : mask(15), count(0), column(col), intKeys(isInt) {
+        hashes.assign(16, 0);
+        rowIds.assign(16, EMPTY);
+    }
+
+    // Pre-size for n keys (bulk load never rehashes)
+    void reserve(size_t n) {
+        while ((mask + 1) < n * 2) grow();
+    }
+
+    // ---- int keys ----
+    bool containsInt(int key) const {
+        return rowIds[probe(hashInt(key), key, nullptr, 0)] != EMPTY;
+    }
+
+    // Returns row id or -1
+    long long findInt(int key) const {
+        uint32_t r = rowIds[probe(hashInt(key), key, nullptr, 0)];
+        return r == EMPTY ? -1 : (long long)r;
+    }
+
+    // ---- string keys ----
+    bool containsString(const string& key) const {
+        uint64_t h = hashBytes(key.data(), key.size());
+        return rowIds[probe(h, 0, key.data(), key.size())] != EMPTY;
+    }
+
+    long long findString(const string& key) const {
+        uint64_t h = hashBytes(key.data(), key.size());
+        uint32_t r = rowIds[probe(h, 0, key.data(), key.size())];
+        return r == EMPTY ? -1 : (long long)r;
+    }
+
+    // Register row 'r' (its key must already be stored in the column)
+    void add(uint32_t r) {
+        if ((count + 1) * 2 > mask + 1) grow();
+        uint64_t h;
+        size_t slot;
+        if (intKeys) {
+            int key = column->ints[r];
+            h = hashInt(key);
+            slot = probe(h, key, nullptr, 0);
+        } else {
+            h = hashBytes(column->stringData(r), column->stringLength(r));
+            slot = probe(h, 0, column->stringData(r), column->stringLength(r));
+        }
+        hashes[slot] = h;
+        rowIds[slot] = r;
+        count++;
+    }
+
+    size_t memoryUsage() const {
+        return hashes.capacity() * sizeof(uint64_t) + rowIds.capacity() * sizeof(uint32_t);
+    }
+};
+
+// Static constant definition (needed because vector::assign takes it by reference)
+const uint32_t HashIndex::EMPTY;
+
+// ===== TABLE WITH PER-COLUMN INDEXES =====
+class Table {
+private:
+    string tableName;
+    vector<Column> columns;
+    vector<ColumnData*> data;
+    vector<HashIndex*> indexes;   // nullptr when the column has no PK/UNIQUE bit
+    vector<int> parsed;           // Scratch buffer reused by every INSERT
+    size_t rowCount;
+
+    static bool parseInt(const string& s, int& out) {
+        if (s.empty()) return false;
+        char* end = nullptr;
+        errno = 0;
+        long v = strtol(s.c_str(), &end, 10);
+        if (*end != '\0') return false;
+        if (errno == ERANGE || v < INT_MIN || v > INT_MAX) return false;   // Would not fit: reject, never wrap
+        out = (int)v;
+        return true;
+    }
+
+public:
+    Table(string name) : tableName(name), rowCount(0) {}
+
+    ~Table() {
+        for (size_t c = 0; c < data.size(); c++) {
+            delete data[c];
+            delete indexes[c];
+        }
+    }
+
+    void addColumn(const Column& col) {
+        columns.push_back(col);
+        data.push_back(new ColumnData());
+        indexes.push_back(col.needsIndex() ? new HashIndex(data.back(), col.isInt()) : nullptr);
+    }
+
+    void reserve(size_t n) {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].isInt()) data[c]->ints.reserve(n);
+            else                    data[c]->offsets.reserve(n + 1);
+            if (indexes[c]) indexes[c]->reserve(n);
+        }
+    }
+
+    // INSERT with O(1) duplicate check per constrained column
+    bool insert(const Row& row, bool verbose = true) {
+        if (row.values.size() != columns.size()) return false;
+
+        parsed.assign(columns.size(), 0);
+        for (size_t c = 0; c < columns.size(); c++) {
+            const string& v = row.values[c];
+            if ((columns[c].constraints & (NOT_NULL | PRIMARY_KEY)) && v.empty()) {
+                if (verbose) cout << "Error: " << columns[c].name << " cannot be NULL!" << endl;
+                return false;
+            }
+            if (v.empty()) continue;      // NULL in a nullable column: not parsed, not indexed
+            if (columns[c].isInt() && !parseInt(v, parsed[c])) {
+                if (verbose) cout << "Error: " << columns[c].name << " must be int!" << endl;
+                return false;
+            }
+            // NULL ("") is not a value: a nullable UNIQUE column may hold many NULLs
+            if (indexes[c]) {
+                bool duplicate = columns[c].isInt() ? indexes[c]->containsInt(parsed[c])
+                                                    : indexes[c]->containsString(v);
+                if (duplicate) {
+                    if (verbose) cout << "Error: Duplicate value '" << v << "' for "
+                                      << columns[c].name << "!" << endl;
+                    return false;
+                }
+            }
+        }
+
+        uint32_t r = (uint32_t)rowCount;
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].isInt()) {
+                data[c]->ints.push_back(parsed[c]);
+            } else {
+                const string& v = row.values[c];
+                data[c]->bytes.insert(data[c]->bytes.end(), v.begin(), v.end());
+                data[c]->offsets.push_back((uint32_t)data[c]->bytes.size());
+            }
+            if (row.values[c].empty()) data[c]->markNull(r);                    // Int slot holds 0
+            else if (indexes[c]) indexes[c]->add(r);                             // NULLs stay out of the index
+        }
+        rowCount++;
+        return true;
+    }
+
+    int findColumn(const string& name) const {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].name == name) return (int)c;
+        }
+        return -1;
+    }
+
+    // WHERE col = value: uses the index when one exists, else falls back to a scan
+    long long findRow(const string& colName, const string& value) const {
+        int c = findColumn(colName);
+        if (c < 0) return -1;
+        if (columns[c].isInt()) {
+            int key;
+            if (!parseInt(value, key)) return -1;
+            if (indexes[c]) return indexes[c]->findInt(key);
+            for (size_t r = 0; r < rowCount; r++) {
+                if (data[c]->ints[r] == key && !data[c]->isNull(r)) return (long long)r;   // NULL equals nothing
+            }
+        } else {
+            if (indexes[c]) return indexes[c]->findString(value);
+            for (size_t r = 0; r < rowCount; r++) {
+                if (!data[c]->isNull(r) && string(data[c]->stringData(r), data[c]->stringLength(r)) == value) {
+                    return (long long)r;
+                }
+            }
+        }
+        return -1;
+    }
+
+    void printRow(long long r) const {
+        if (r < 0) {
+            cout << "(no rows)" << endl;
+            return;
+        }
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (data[c]->isNull(r)) cout << "NULL\t";
+            else if (columns[c].isInt()) cout << data[c]->ints[r] << "\t";
+            else cout << string(data[c]->stringData(r), data[c]->stringLength(r)) << "\t";
+        }
+        cout << endl;
+    }
+
+    size_t size() const {
+        return rowCount;
+    }
+
+    size_t indexMemory() const {
+        size_t total = 0;
+        for (size_t c = 0; c < indexes.size(); c++) {
+            if (indexes[c]) total += indexes[c]->memoryUsage();
+        }
+        return total;
+    }
+};
+
+// ===== BASELINE: linear duplicate check over vector<Row*> =====
+bool insertLinear(vector<Row*>& rows, const Row& row) {
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (rows[i]->values[0] == row.values[0]) return false;
+    }
+    rows.push_back(new Row(row));
+    return true;
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== CREATE TABLE users =====" << endl;
+    Table users("users");
+    users.addColumn(Column("id", "int", PRIMARY_KEY | NOT_NULL));
+    users.addColumn(Column("email", "string", UNIQUE | NOT_NULL));
+    users.addColumn(Column("age", "int", 0));
+
+    cout << "\n===== INSERT with constraint checks =====" << endl;
+    Row r1; r1.values = {"1", "ali@mail.com", "20"};
+    Row r2; r2.values = {"2", "sara@mail.com", "21"};
+    Row dupId; dupId.values = {"1", "omar@mail.com", "22"};
+    Row dupEmail; dupEmail.values = {"3", "sara@mail.com", "23"};
+    if (users.insert(r1)) cout << "Record inserted." << endl;
+    if (users.insert(r2)) cout << "Record inserted." << endl;
+    users.insert(dupId);       // Rejected by PRIMARY KEY index
+    users.insert(dupEmail);    // Rejected by UNIQUE index
+    Row hugeId; hugeId.values = {"99999999999", "big@mail.com", "24"};
+    users.insert(hugeId);      // Rejected: id does not fit in int (no silent wrap-around)
+    Row noAge; noAge.values = {"4", "hina@mail.com", ""};
+    if (users.insert(noAge)) cout << "Record inserted (age is NULL)." << endl;     // age is a nullable int
+
+    // Nullable UNIQUE column: NULLs are not duplicates of each other
+    Table phones("phones");
+    phones.addColumn(Column("id", "int", PRIMARY_KEY | NOT_NULL));
+    phones.addColumn(Column("phone", "string", UNIQUE));
+    Row p1; p1.values = {"1", ""};
+    Row p2; p2.values = {"2", ""};
+    Row p3; p3.values = {"3", "0300-1234567"};
+    Row p4; p4.values = {"4", "0300-1234567"};
+    bool nullsOk = phones.insert(p1) && phones.insert(p2) && phones.insert(p3);
+    bool dupRejected = !phones.insert(p4, false);
+    cout << "Two NULL phones accepted: " << (nullsOk ? "YES" : "NO")
+         << ", duplicate phone rejected: " << (dupRejected ? "YES" : "NO") << endl;
+
+    cout << "\n===== SELECT * FROM users WHERE id = 2 =====" << endl;
+    users.printRow(users.findRow("id", "2"));
+    cout << "\n===== SELECT * FROM users WHERE email = ali@mail.com =====" << endl;
+    users.printRow(users.findRow("email", "ali@mail.com"));
+    cout << "\n===== SELECT * FROM users WHERE id = 4 =====" << endl;
+    users.printRow(users.findRow("id", "4"));
+    cout << "\n===== SELECT * FROM users WHERE age = 0 (NULL matches nothing) =====" << endl;
+    users.printRow(users.findRow("age", "0"));
+
+    cout << "\n===== BULK LOAD: linear check vs hash index =====" << endl;
+    const size_t SMALL = 20000;
+    const size_t LARGE = 2000000;
+
+    Row row;
+    row.values.resize(3);
+
+    vector<Row*> linearRows;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < SMALL; i++) {
+        row.values[0] = to_string(i);
+        row.values[1] = "user" + to_string(i) + "@mail.com";
+        row.values[2] = "30";
+        insertLinear(linearRows, row);
+    }
+    double linearMs = millisecondsSince(start);
+    cout << "Linear check : " << SMALL << " rows in " << linearMs << " ms" << endl;
+    cout << "  (O(n^2): 10M rows would take ~"
+         << (int)(linearMs * (10000000.0 / SMALL) * (10000000.0 / SMALL) / 3600000.0)
+         << " hours)" << endl;
+    for (size_t i = 0; i < linearRows.size(); i++) delete linearRows[i];
+
+    Table big("big_users");
+    big.addColumn(Column("id", "int", PRIMARY_KEY | NOT_NULL));
+    big.addColumn(Column("email", "string", UNIQUE | NOT_NULL));
+    big.addColumn(Column("age", "int", 0));
+    big.reserve(LARGE);
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < LARGE; i++) {
+        row.values[0] = to_string(i);
+        row.values[1] = "user" + to_string(i) + "@mail.com";
+        big.insert(row, false);
+    }
+    double hashMs = millisecondsSince(start);
+    cout << "Hash index   : " << big.size() << " rows in " << hashMs << " ms" << endl;
+    cout << "Index memory : " << big.indexMemory() / (1024 * 1024) << " MB" << endl;
+
+    start = chrono::steady_clock::now();
+    long long found = 0;
+    for (size_t i = 0; i < 1000000; i++) {
+        if (big.findRow("id", to_string((i * 7919) % LARGE)) >= 0) found++;
+    }
+    cout << "1M point lookups (WHERE id = ...): " << found << " hits in "
+         << millisecondsSince(start) << " ms" << endl;
+
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Why Not Linear Checks
+       - Each INSERT compares against every existing row
+       - n inserts -> n*(n-1)/2 comparisons -> quadratic bulk load
+
+    2. Open Addressing
+       - All entries live in ONE flat array (no per-entry allocation)
+       - hash & mask picks a slot; on collision try slot+1, slot+2, ...
+       - Capacity is a power of two so "% capacity" becomes "& mask" (bitwise!)
+
+    3. Load Factor
+       - Table doubles when more than half full
+       - Keeps probe sequences short -> O(1) average insert and lookup
+
+    4. Storing Row Ids Instead of Keys
+       - Slot = (64-bit hash, 32-bit row id)
+       - Full hash compared first: string bytes only compared on a real match
+       - Works for int and string columns with the same code
+
+    5. Bitwise Constraint Checks
+       - constraints & (PRIMARY_KEY | UNIQUE) decides which columns get an index
+       - constraints & NOT_NULL still rejects empty values
+       - NULL ("") is never indexed: a nullable UNIQUE column may repeat NULL
+       - NULL skips the int check and sets a bit in the column's null bitmap,
+         so a nullable int column accepts it and WHERE scans never match it
+
+    6. Point Lookups
+       - WHERE id = 42 probes the same index -> no table scan
+*/
@@ -0,0 +1,381 @@
+/*
+    3) VECTORIZED WHERE CLAUSE (Batch Executor + Selection Vectors)
+
+    Explanation:
+    - Row-at-a-time interpreter: for every row, for every predicate,
+      look up Row::values[c], atoi() it, switch on the operator -> many branches per row
+    - Batch executor: process a BLOCK of 2048 values of one typed column at a time
+      -> one tight loop per (predicate, block), no per-row dispatch
+    - Result of a predicate = selection BITMAP (1 bit per row in the block)
+    - AND of predicates = bitwise AND of bitmaps (64 rows per instruction)
+    - Bitmap -> selection VECTOR (list of matching row indexes) for the next operator
+    - Int comparisons use SIMD: AVX2 (8 ints), SSE2 (4 ints), scalar fallback
+
+    Compile with AVX2 enabled for the widest kernel:
+        g++ -O2 -mavx2 3_vectorized_where.cpp
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+const size_t BLOCK_SIZE = 2048;               // Rows per batch
+const size_t BLOCK_WORDS = BLOCK_SIZE / 64;   // uint64_t words per bitmap
+
+// ===== PREDICATE: column <op> constant =====
+enum CompareOp { OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE };
+
+struct Predicate {
+    int column;
+    CompareOp op;
+    int value;
+};
+
+const char* opName(CompareOp op) {
+    switch (op) {
+        case OP_EQ: return "=";
+        case OP_NE: return "!=";
+        case OP_LT: return "<";
+        case OP_LE: return "<=";
+        case OP_GT: return ">";
+        case OP_GE: return ">=";
+    }
+    return "?";
+}
+
+// ===== SCALAR KERNEL (works everywhere) =====
+// Branch-free: the comparison result (0 or 1) is shifted into place
+template <CompareOp OP>
+inline bool compare(int a, int b) {
+    if (OP == OP_EQ) return a == b;
+    if (OP == OP_NE) return a != b;
+    if (OP == OP_LT) return a < b;
+    if (OP == OP_LE) return a <= b;
+    if (OP == OP_GT) return a > b;
+    return a >= b;
+}
+
+template <CompareOp OP>
+void filterScalar(const int* values, size_t begin, size_t n, int c, uint64_t* bitmap) {
+    for (size_t i = begin; i < n; i++) {
+        bitmap[i >> 6] |= (uint64_t)compare<OP>(values[i], c) << (i & 63);
+    }
+}
+
+// ===== SIMD KERNELS =====
+// Only GT, LT and EQ exist as instructions; the others are their negation:
+//   NE = ~EQ,  GE = ~LT,  LE = ~GT
+#if defined(__AVX2__)
+const char* KERNEL_NAME = "AVX2 (8 x int32)";
+
+template <CompareOp OP>
+inline unsigned compareMask(const int* p, __m256i c) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    __m256i m;
+    if (OP == OP_EQ || OP == OP_NE) m = _mm256_cmpeq_epi32(v, c);
+    else if (OP == OP_GT || OP == OP_LE) m = _mm256_cmpgt_epi32(v, c);
+    else m = _mm256_cmpgt_epi32(c, v);
+    unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(m));
+    if (OP == OP_NE || OP == OP_LE || OP == OP_GE) bits = ~bits & 0xFF;
+    return bits;
+}
+
+template <CompareOp OP>
+void filterBlock(const int* values, size_t n, int constant, uint64_t* bitmap) {
+    __m256i c = _mm256_set1_epi32(constant);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        uint64_t word = 0;
+        for (size_t j = 0; j < 64; j += 8) {
+            word |= (uint64_t)compareMask<OP>(values + i + j, c) << j;
+        }
+        bitmap[i >> 6] = word;
+    }
+    filterScalar<OP>(values, i, n, constant, bitmap);
+}
+
+#elif defined(__SSE2__)
+const char* KERNEL_NAME = "SSE2 (4 x int32)";
+
+template <CompareOp OP>
+inline unsigned compareMask(const int* p, __m128i c) {
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i m;
+    if (OP == OP_EQ || OP == OP_NE) m = _mm_cmpeq_epi32(v, c);
+    else if (OP == OP_GT || OP == OP_LE) m = _mm_cmpgt_epi32(v, c);
+    else m = _mm_cmplt_epi32(v, c);
+    unsigned bits = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(m));
+    if (OP == OP_NE || OP == OP_LE || OP == OP_GE) bits = ~bits & 0xF;
+    return bits;
+}
+
+template <CompareOp OP>
+void filterBlock(const int* values, size_t n, int constant, uint64_t* bitmap) {
+    __m128i c = _mm_set1_epi32(constant);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        uint64_t word = 0;
+        for (size_t j = 0; j < 64; j += 4) {
+            word |= (uint64_t)compareMask<OP>(values + i + j, c) << j;
+        }
+        bitmap[i >> 6] = word;
+    }
+    filterScalar<OP>(values, i, n, constant, bitmap);
+}
+
+#else
+const char* KERNEL_NAME = "scalar";
+
+template <CompareOp OP>
+void filterBlock(const int* values, size_t n, int constant, uint64_t* bitmap) {
+    filterScalar<OP>(values, 0, n, constant, bitmap);
+}
+#endif
+
+// Runtime operator -> compiled kernel (one switch per BLOCK, not per row)
+void evaluatePredicate(const int* values, size_t n, CompareOp op, int c, uint64_t* bitmap) {
+    for (size_t w = 0; w < BLOCK_WORDS; w++) bitmap[w] = 0;
+    switch (op) {
+        case OP_EQ: filterBlock<OP_EQ>(values, n, c, bitmap); break;
+        case OP_NE: filterBlock<OP_NE>(values, n, c, bitmap); break;
+        case OP_LT: filterBlock<OP_LT>(values, n, c, bitmap); break;
+        case OP_LE: filterBlock<OP_LE>(values, n, c, bitmap); break;
+        case OP_GT: filterBlock<OP_GT>(values, n, c, bitmap); break;
+        case OP_GE: filterBlock<OP_GE>(values, n, c, bitmap); break;
+    }
+}
+
+// ===== BITMAP -> SELECTION VECTOR =====
+// Count trailing zeros finds the next set bit; x & (x - 1) clears it
+size_t bitmapToSelection(const uint64_t* bitmap, uint16_t* selection) {
+    size_t count = 0;
+    for (size_t w = 0; w < BLOCK_WORDS; w++) {
+        uint64_t bits = bitmap[w];
+        while (bits) {
+            selection[count++] = (uint16_t)(w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+    return count;
+}
+
+// ===== TABLE: typed int columns (column-major) =====
+class Table {
+public:
+    string tableName;
+    vector<string> columnNames;
+    vector< vector<int> > columns;
+
+    Table(string name) : tableName(name) {}
+
+    void addColumn(const string& name) {
+        columnNames.push_back(name);
+        columns.push_back(vector<int>());
+    }
+
+    size_t size() const {
+        return columns.empty() ? 0 : columns[0].size();
+    }
+};
+
+// All n rows of a block selected (empty WHERE clause)
+void selectAll(size_t n, uint64_t* bitmap) {
+    for (size_t w = 0; w < BLOCK_WORDS; w++) {
+        size_t first = w * 64;
+        if (first + 64 <= n) bitmap[w] = ~0ULL;
+        else bitmap[w] = first < n ? (1ULL << (n - first)) - 1 : 0;
+    }
+}
+
+// ===== BATCH EXECUTOR =====
+// SELECT COUNT(*), SUM(sumColumn) FROM table WHERE p1 AND p2 AND ...
+struct QueryResult {
+    long long count;
+    long long sum;
+};
+
+QueryResult executeBatched(const Table& table, const vector<Predicate>& where, int sumColumn) {
+    QueryResult result = {0, 0};
+    uint64_t bitmap[BLOCK_WORDS];
+    uint64_t scratch[BLOCK_WORDS];
+    uint16_t selection[BLOCK_SIZE];
+    size_t rows = table.size();
+
+    for (size_t start = 0; start < rows; start += BLOCK_SIZE) {
+        size_t n = (rows - start < BLOCK_SIZE) ? rows - start : BLOCK_SIZE;
+
+        // 1) First predicate writes the bitmap (no WHERE: every row of the block)
+        if (where.empty()) selectAll(n, bitmap);
+        else evaluatePredicate(table.columns[where[0].column].data() + start, n,
+                               where[0].op, where[0].value, bitmap);
+
+        // 2) Remaining predicates AND into it (64 rows per AND)
+        for (size_t p = 1; p < where.size(); p++) {
+            evaluatePredicate(table.columns[where[p].column].data() + start, n,
+                              where[p].op, where[p].value, scratch);
+            for (size_t w = 0; w < BLOCK_WORDS; w++) bitmap[w] &= scratch[w];
+        }
+
+        // 3) Selection vector drives the projection/aggregate
+        size_t selected = bitmapToSelection(bitmap, selection);
+        const int* sumValues = table.columns[sumColumn].data() + start;
+        for (size_t i = 0; i < selected; i++) result.sum += sumValues[selection[i]];
+        result.count += selected;
+    }
+    return result;
+}
+
+// ===== BASELINE: row-at-a-time interpreter over Row::values strings =====
+class Row {
+public:
+    vector<string> values;
+};
+
+bool evalRow(const Row* row, const Predicate& p) {
+    int v = atoi(row->values[p.column].c_str());
+    switch (p.op) {
+        case OP_EQ: return v == p.value;
+        case OP_NE: return v != p.value;
+        case OP_LT: return v < p.value;
+        case OP_LE: return v <= p.value;
+        case OP_GT: return v > p.value;
+        case OP_GE: return v >= p.value;
+    }
+    return false;
+}
+
+QueryResult executeRowAtATime(const vector<Row*>& rows, const vector<Predicate>& where, int sumColumn) {
+    QueryResult result = {0, 0};
+    for (size_t r = 0; r < rows.size(); r++) {
+        bool match = true;
+        for (size_t p = 0; p < where.size() && match; p++) match = evalRow(rows[r], where[p]);
+        if (match) {
+            result.count++;
+            result.sum += atoi(rows[r]->values[sumColumn].c_str());
+        }
+    }
+    return result;
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== SIMD kernel: " << KERNEL_NAME << " =====" << endl;
+
+    // orders(id, customer, amount, age)
+    const size_t N = 2000000;
+    Table orders("orders");
+    orders.addColumn("id");
+    orders.addColumn("customer");
+    orders.addColumn("amount");
+    orders.addColumn("age");
+
+    vector<Row*> rows;
+    rows.reserve(N);
+    unsigned seed = 12345;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;           // Simple LCG (deterministic data)
+        int customer = (int)((seed >> 8) % 10000);
+        int amount = (int)((seed >> 4) % 1000);
+        int age = 18 + (int)((seed >> 16) % 60);
+        orders.columns[0].push_back((int)i);
+        orders.columns[1].push_back(customer);
+        orders.columns[2].push_back(amount);
+        orders.columns[3].push_back(age);
+
+        Row* row = new Row();
+        row->values = {to_string(i), to_string(customer), to_string(amount), to_string(age)};
+        rows.push_back(row);
+    }
+
+    // SELECT COUNT(*), SUM(amount) FROM orders WHERE age > 20 AND age < 30 AND amount >= 500
+    vector<Predicate> where = {{3, OP_GT, 20}, {3, OP_LT, 30}, {2, OP_GE, 500}};
+
+    cout << "\nSELECT COUNT(*), SUM(amount) FROM orders WHERE ";
+    for (size_t p = 0; p < where.size(); p++) {
+        if (p) cout << " AND ";
+        cout << orders.columnNames[where[p].column] << " " << opName(where[p].op) << " " << where[p].value;
+    }
+    cout << endl;
+
+    auto start = chrono::steady_clock::now();
+    QueryResult slow = executeRowAtATime(rows, where, 2);
+    double slowMs = millisecondsSince(start);
+
+    start = chrono::steady_clock::now();
+    QueryResult fast = executeBatched(orders, where, 2);
+    double fastMs = millisecondsSince(start);
+
+    cout << "\n===== RESULTS =====" << endl;
+    cout << "Row-at-a-time : count=" << slow.count << " sum=" << slow.sum
+         << " (" << slowMs << " ms)" << endl;
+    cout << "Vectorized    : count=" << fast.count << " sum=" << fast.sum
+         << " (" << fastMs << " ms)" << endl;
+    cout << "Results match : " << ((slow.count == fast.count && slow.sum == fast.sum) ? "YES" : "NO") << endl;
+    cout << "Speedup       : " << slowMs / fastMs << "x" << endl;
+
+    // Every operator must agree with the scalar definition
+    cout << "\n===== KERNEL SELF-CHECK (all operators) =====" << endl;
+    CompareOp ops[] = {OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE};
+    bool allOk = true;
+    for (int k = 0; k < 6; k++) {
+        vector<Predicate> single = {{3, ops[k], 40}};
+        QueryResult a = executeRowAtATime(rows, single, 2);
+        QueryResult b = executeBatched(orders, single, 2);
+        bool ok = a.count == b.count && a.sum == b.sum;
+        allOk = allOk && ok;
+        cout << "age " << opName(ops[k]) << " 40 : " << (ok ? "OK" : "MISMATCH") << endl;
+    }
+    {
+        vector<Predicate> none;                 // No WHERE: every row
+        QueryResult a = executeRowAtATime(rows, none, 2);
+        QueryResult b = executeBatched(orders, none, 2);
+        bool ok = a.count == b.count && a.sum == b.sum && b.count == (long long)orders.size();
+        allOk = allOk && ok;
+        cout << "no WHERE : " << (ok ? "OK" : "MISMATCH") << endl;
+    }
+
+    for (size_t i = 0; i < rows.size(); i++) delete rows[i];
+    return allOk ? 0 : 1;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Row-at-a-Time Interpretation
+       - Each row: load pointer, parse string, switch on operator, branch on result
+       - CPU cannot predict the branches or vectorize the loop
+
+    2. Block (Batch) Processing
+       - Work on 2048 values of ONE column at a time
+       - Operator dispatch happens once per block instead of once per row
+       - Block fits in L1 cache (2048 * 4 bytes = 8 KB)
+
+    3. Selection Bitmap
+       - Bit i = 1 if row i of the block matches
+       - AND of predicates = bitmap[w] &= other[w] -> 64 rows per instruction
+
+    4. SIMD Comparison
+       - _mm256_cmpgt_epi32 compares 8 ints at once -> 8 lanes of all-ones/zeros
+       - movemask packs the 8 lane signs into an 8-bit integer
+       - NE, LE, GE are computed as the bitwise NOT of EQ, GT, LT
+
+    5. Selection Vector
+       - __builtin_ctzll finds the lowest set bit; bits &= bits - 1 clears it
+       - Later operators (SUM, projection) only touch selected rows
+
+    6. Fallbacks
+       - #if defined(__AVX2__) / __SSE2__ chooses the kernel at compile time
+       - Scalar kernel is branch-free and handles block tails
+*/
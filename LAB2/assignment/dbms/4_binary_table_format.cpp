@@ -0,0 +1,530 @@
+/*
+    4) BINARY MEMORY-MAPPED TABLE FORMAT (SAVE / LOAD)
+
+    Explanation:
+    - Text format (dbms.md): "TABLE users / id int 3 / DATA / 1 Ali 20"
+      -> every LOAD must tokenize every value and convert text to int
+    - Binary format: the file IS the in-memory column layout
+      -> LOAD = open + mmap, no parsing, no copying
+    - Pages are loaded by the OS lazily, the first time a column is touched
+    - Text format is kept as IMPORT / EXPORT (human readable, portable)
+
+    File layout (all sizes little-endian, segments aligned to 64 bytes):
+
+        +--------------------+  offset 0
+        | FileHeader         |  magic, version, rowCount, columnCount
+        +--------------------+  offset 64
+        | ColumnDescriptor[] |  name, type, constraint bitmask, segment offsets
+        +--------------------+  aligned
+        | int segment        |  int32[rowCount]
+        +--------------------+  aligned
+        | string offsets     |  uint32[rowCount + 1]
+        | string bytes       |  char[...]
+        +--------------------+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+using namespace std;
+
+const unsigned int PRIMARY_KEY = 1;
+const unsigned int NOT_NULL    = 2;
+const unsigned int UNIQUE      = 4;
+
+// ===== ON-DISK STRUCTURES =====
+const char FILE_MAGIC[8] = {'M', 'I', 'N', 'I', 'D', 'B', 'T', '1'};
+const uint32_t FORMAT_VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;   // Reads back differently on big-endian
+const uint64_t SEGMENT_ALIGN = 64;              // One cache line
+
+const uint32_t TYPE_INT = 1;
+const uint32_t TYPE_STRING = 2;
+
+struct FileHeader {            // 64 bytes
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t rowCount;
+    uint32_t columnCount;
+    uint32_t descriptorSize;
+    char tableName[32];
+};
+
+struct ColumnDescriptor {      // 64 bytes
+    char name[24];
+    uint32_t type;
+    uint32_t constraints;      // Same bitmask as the text format (1 | 2 | 4)
+    uint64_t dataOffset;       // int32[] or uint32 offsets[]
+    uint64_t dataSize;
+    uint64_t bytesOffset;      // string bytes (0 for int columns)
+    uint64_t bytesSize;
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+static_assert(sizeof(ColumnDescriptor) == 64, "ColumnDescriptor must be 64 bytes");
+
+uint64_t alignUp(uint64_t x) {
+    return (x + SEGMENT_ALIGN - 1) & ~(SEGMENT_ALIGN - 1);
+}
+
+// ===== IN-MEMORY TABLE (column-major, see 1_columnar_storage.cpp) =====
+class Column {
+public:
+    string name;
+    string type;
+    unsigned int constraints;
+
+    Column(string n, string t, unsigned int c) : name(n), type(t), constraints(c) {}
+
+    bool isInt() const {
+        return type == "int";
+    }
+};
+
+class ColumnData {
+public:
+    vector<int> ints;
+    vector<uint32_t> offsets;
+    vector<char> bytes;
+
+    ColumnData() {
+        offsets.push_back(0);
+    }
+};
+
+class Table {
+public:
+    string tableName;
+    vector<Column> columns;
+    vector<ColumnData> data;
+    size_t rowCount;
+
+    Table(string name) : tableName(name), rowCount(0) {}
+
+    void addColumn(const Column& col) {
+        columns.push_back(col);
+        data.push_back(ColumnData());
+    }
+
+    void insert(const vector<string>& values) {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].isInt()) {
+                data[c].ints.push_back(atoi(values[c].c_str()));
+            } else {
+                data[c].bytes.insert(data[c].bytes.end(), values[c].begin(), values[c].end());
+                data[c].offsets.push_back((uint32_t)data[c].bytes.size());
+            }
+        }
+        rowCount++;
+    }
+};
+
+// ===== TEXT FORMAT (import / export path) =====
+bool exportText(const Table& t, const string& filename) {
+    ofstream out(filename);
+    if (!out) return false;
+    out << "TABLE " << t.tableName << "\n";
+    for (size_t c = 0; c < t.columns.size(); c++) {
+        out << t.columns[c].name << " " << t.columns[c].type << " " << t.columns[c].constraints << "\n";
+    }
+    out << "DATA\n";
+    for (size_t r = 0; r < t.rowCount; r++) {
+        for (size_t c = 0; c < t.columns.size(); c++) {
+            if (c) out << " ";
+            const ColumnData& d = t.data[c];
+            if (t.columns[c].isInt()) out << d.ints[r];
+            else out.write(d.bytes.data() + d.offsets[r], d.offsets[r + 1] - d.offsets[r]);
+        }
+        out << "\n";
+    }
+    return true;
+}
+
+bool importText(Table& t, const string& filename) {
+    ifstream in(filename);
+    if (!in) return false;
+    string word, line;
+    in >> word >> t.tableName;
+    while (in >> word && word != "DATA") {
+        string type;
+        unsigned int flags;
+        in >> type >> flags;
+        t.addColumn(Column(word, type, flags));
+    }
+    getline(in, line);
+    vector<string> values(t.columns.size());
+    while (getline(in, line)) {
+        if (line.empty()) continue;
+        istringstream ss(line);
+        for (size_t c = 0; c < values.size(); c++) ss >> values[c];
+        t.insert(values);
+    }
+    return true;
+}
+
+// ===== BINARY WRITER =====
+void writePadding(ofstream& out, uint64_t& pos, uint64_t target) {
+    static const char zeros[SEGMENT_ALIGN] = {0};
+    out.write(zeros, (streamsize)(target - pos));
+    pos = target;
+}
+
+bool saveBinary(const Table& t, const string& filename) {
+    // 1) Plan the layout: compute every segment offset first
+    vector<ColumnDescriptor> desc(t.columns.size());
+    uint64_t pos = sizeof(FileHeader) + desc.size() * sizeof(ColumnDescriptor);
+
+    for (size_t c = 0; c < t.columns.size(); c++) {
+        ColumnDescriptor& d = desc[c];
+        memset(&d, 0, sizeof(d));
+        strncpy(d.name, t.columns[c].name.c_str(), sizeof(d.name) - 1);
+        d.constraints = t.columns[c].constraints;
+        d.type = t.columns[c].isInt() ? TYPE_INT : TYPE_STRING;
+
+        pos = alignUp(pos);
+        d.dataOffset = pos;
+        if (d.type == TYPE_INT) {
+            d.dataSize = t.rowCount * sizeof(int32_t);
+            pos += d.dataSize;
+        } else {
+            d.dataSize = (t.rowCount + 1) * sizeof(uint32_t);
+            pos += d.dataSize;
+            d.bytesOffset = pos;
+            d.bytesSize = t.data[c].bytes.size();
+            pos += d.bytesSize;
+        }
+    }
+
+    FileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, FILE_MAGIC, sizeof(h.magic));
+    h.version = FORMAT_VERSION;
+    h.byteOrder = BYTE_ORDER_MARK;
+    h.rowCount = t.rowCount;
+    h.columnCount = (uint32_t)t.columns.size();
+    h.descriptorSize = sizeof(ColumnDescriptor);
+    strncpy(h.tableName, t.tableName.c_str(), sizeof(h.tableName) - 1);
+
+    // 2) Write to a temp file, then rename (a crash never leaves a half file)
+    string tmp = filename + ".tmp";
+    ofstream out(tmp, ios::binary);
+    if (!out) return false;
+
+    out.write((const char*)&h, sizeof(h));
+    out.write((const char*)desc.data(), (streamsize)(desc.size() * sizeof(ColumnDescriptor)));
+    pos = sizeof(FileHeader) + desc.size() * sizeof(ColumnDescriptor);
+
+    for (size_t c = 0; c < t.columns.size(); c++) {
+        writePadding(out, pos, desc[c].dataOffset);
+        if (desc[c].type == TYPE_INT) {
+            out.write((const char*)t.data[c].ints.data(), (streamsize)desc[c].dataSize);
+        } else {
+            out.write((const char*)t.data[c].offsets.data(), (streamsize)desc[c].dataSize);
+            out.write(t.data[c].bytes.data(), (streamsize)desc[c].bytesSize);
+        }
+        pos += desc[c].dataSize + desc[c].bytesSize;
+    }
+    out.close();
+    if (!out) return false;
+    return rename(tmp.c_str(), filename.c_str()) == 0;
+}
+
+// ===== BINARY READER: zero-copy mapped table =====
+// Column pointers point straight into the mapped file.
+class MappedTable {
+private:
+    const char* base;
+    size_t fileSize;
+    bool mapped;              // true: munmap, false: delete[] (fallback path)
+    const FileHeader* header;
+    const ColumnDescriptor* desc;
+
+    // Reject any segment that would read past the end of the file
+    bool inBounds(uint64_t offset, uint64_t size) const {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+
+    // Every check a corrupt file could defeat: sizes are compared by division
+    // (no overflowing multiply), names must end in '\0', and string offsets
+    // must be monotonic and inside the bytes segment, so getString() and
+    // printSchema() can never read outside the file
+    bool validate(string& error) const {
+        if (fileSize < sizeof(FileHeader)) { error = "file too small"; return false; }
+        if (memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) { error = "bad magic"; return false; }
+        if (header->byteOrder != BYTE_ORDER_MARK) { error = "wrong byte order"; return false; }
+        if (header->version != FORMAT_VERSION) { error = "unsupported version"; return false; }
+        if (header->descriptorSize != sizeof(ColumnDescriptor)) { error = "bad descriptor size"; return false; }
+        if (memchr(header->tableName, '\0', sizeof(header->tableName)) == nullptr) { error = "bad table name"; return false; }
+        if (!inBounds(sizeof(FileHeader), (uint64_t)header->columnCount * sizeof(ColumnDescriptor))) {
+            error = "truncated schema";
+            return false;
+        }
+        // rowCount + 1 offsets of 4 bytes must fit in the file (also rules out rowCount * 4 overflowing)
+        if (header->columnCount > 0 && header->rowCount >= fileSize / 4) { error = "bad row count"; return false; }
+        for (uint32_t c = 0; c < header->columnCount; c++) {
+            const ColumnDescriptor& d = desc[c];
+            if (d.type != TYPE_INT && d.type != TYPE_STRING) {
+                error = "unknown type for column " + to_string(c);
+                return false;
+            }
+            if (memchr(d.name, '\0', sizeof(d.name)) == nullptr) {
+                error = "bad name for column " + to_string(c);
+                return false;
+            }
+            if (d.dataOffset % SEGMENT_ALIGN != 0 || !inBounds(d.dataOffset, d.dataSize) ||
+                !inBounds(d.bytesOffset, d.bytesSize)) {
+                error = "bad segment for column " + to_string(c);
+                return false;
+            }
+            uint64_t expected = (d.type == TYPE_INT ? header->rowCount : header->rowCount + 1) * 4;
+            if (d.dataSize != expected) { error = "bad segment size"; return false; }
+            if (d.type == TYPE_STRING) {
+                const uint32_t* off = stringOffsets(c);
+                uint32_t previous = 0;
+                for (uint64_t r = 0; r <= header->rowCount; r++) {
+                    if (off[r] < previous || off[r] > d.bytesSize) {
+                        error = "bad string offsets in column " + to_string(c);
+                        return false;
+                    }
+                    previous = off[r];
+                }
+                if (off[0] != 0 || off[header->rowCount] != d.bytesSize) {
+                    error = "bad string offsets in column " + to_string(c);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    const uint32_t* stringOffsets(uint32_t c) const {
+        return (const uint32_t*)(base + desc[c].dataOffset);
+    }
+
+public:
+    MappedTable() : base(nullptr), fileSize(0), mapped(false), header(nullptr), desc(nullptr) {}
+
+    ~MappedTable() {
+        close();
+    }
+
+    bool open(const string& filename, string& error) {
+        close();
+#ifdef HAVE_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open file"; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); error = "cannot stat file"; return false; }
+        fileSize = (size_t)st.st_size;
+        void* p = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);                      // Mapping stays valid after close
+        if (p == MAP_FAILED) { error = "mmap failed"; return false; }
+        base = (const char*)p;
+        mapped = true;
+#else
+        // Portable fallback: one bulk read, still no parsing
+        ifstream in(filename, ios::binary | ios::ate);
+        if (!in) { error = "cannot open file"; return false; }
+        fileSize = (size_t)in.tellg();
+        char* buffer = new char[fileSize];
+        in.seekg(0);
+        in.read(buffer, (streamsize)fileSize);
+        base = buffer;
+        mapped = false;
+#endif
+        header = (const FileHeader*)base;
+        desc = (const ColumnDescriptor*)(base + sizeof(FileHeader));
+        if (!validate(error)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (!base) return;
+#ifdef HAVE_MMAP
+        if (mapped) munmap((void*)base, fileSize);
+        else delete[] base;
+#else
+        delete[] base;
+#endif
+        base = nullptr;
+        header = nullptr;
+        desc = nullptr;
+    }
+
+    size_t size() const {
+        return (size_t)header->rowCount;
+    }
+
+    int findColumn(const string& name) const {
+        for (uint32_t c = 0; c < header->columnCount; c++) {
+            if (strncmp(desc[c].name, name.c_str(), sizeof(desc[c].name)) == 0) return (int)c;
+        }
+        return -1;
+    }
+
+    // Zero copy: pointer into the mapping
+    const int32_t* intColumn(int c) const {
+        return (const int32_t*)(base + desc[c].dataOffset);
+    }
+
+    string getString(int c, size_t r) const {
+        const uint32_t* off = stringOffsets(c);
+        return string(base + desc[c].bytesOffset + off[r], off[r + 1] - off[r]);
+    }
+
+    void printSchema() const {
+        cout << "TABLE " << header->tableName << " (v" << header->version << ", "
+             << header->rowCount << " rows)" << endl;
+        for (uint32_t c = 0; c < header->columnCount; c++) {
+            cout << "  " << desc[c].name << " " << (desc[c].type == TYPE_INT ? "int" : "string")
+                 << " " << desc[c].constraints;
+            if (desc[c].constraints & PRIMARY_KEY) cout << " [PK]";
+            if (desc[c].constraints & NOT_NULL) cout << " [NOT NULL]";
+            if (desc[c].constraints & UNIQUE) cout << " [UNIQUE]";
+            cout << endl;
+        }
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== BUILD users TABLE =====" << endl;
+    const size_t N = 1000000;
+    const char* names[] = {"Ali", "Sara", "Omar", "Hina", "Bilal", "Ayesha"};
+    Table users("users");
+    users.addColumn(Column("id", "int", PRIMARY_KEY | NOT_NULL));
+    users.addColumn(Column("name", "string", NOT_NULL));
+    users.addColumn(Column("age", "int", 0));
+    vector<string> values(3);
+    for (size_t i = 0; i < N; i++) {
+        values[0] = to_string(i + 1);
+        values[1] = names[i % 6];
+        values[2] = to_string(18 + (int)(i % 50));
+        users.insert(values);
+    }
+    cout << users.rowCount << " rows" << endl;
+
+    cout << "\n===== SAVE: text export vs binary =====" << endl;
+    auto start = chrono::steady_clock::now();
+    exportText(users, "users.txt");
+    cout << "Text export   : " << millisecondsSince(start) << " ms" << endl;
+
+    start = chrono::steady_clock::now();
+    saveBinary(users, "users.mdb");
+    cout << "Binary save   : " << millisecondsSince(start) << " ms" << endl;
+
+    cout << "\n===== LOAD: text import vs mmap =====" << endl;
+    start = chrono::steady_clock::now();
+    Table imported("");
+    importText(imported, "users.txt");
+    cout << "Text import   : " << millisecondsSince(start) << " ms (" << imported.rowCount << " rows parsed)" << endl;
+
+    start = chrono::steady_clock::now();
+    MappedTable mt;
+    string error;
+    if (!mt.open("users.mdb", error)) {
+        cout << "Error: " << error << endl;
+        return 1;
+    }
+    cout << "Binary mmap   : " << millisecondsSince(start) << " ms (ready to query)" << endl;
+
+    cout << "\n===== SCHEMA FROM BINARY FILE =====" << endl;
+    mt.printSchema();
+
+    cout << "\n===== QUERY DIRECTLY ON THE MAPPING =====" << endl;
+    int ageCol = mt.findColumn("age");
+    int nameCol = mt.findColumn("name");
+    start = chrono::steady_clock::now();
+    const int32_t* ages = mt.intColumn(ageCol);
+    long long sum = 0;
+    for (size_t i = 0; i < mt.size(); i++) sum += ages[i];
+    cout << "SUM(age) = " << sum << " (" << millisecondsSince(start) << " ms, pages faulted in on demand)" << endl;
+    cout << "Row 2 name = " << mt.getString(nameCol, 1) << endl;
+
+    cout << "\n===== CORRUPTION IS DETECTED =====" << endl;
+    {
+        ofstream bad("broken.mdb", ios::binary);
+        bad << "NOT A TABLE FILE, JUST SOME TEXT.............................................";
+    }
+    MappedTable broken;
+    if (!broken.open("broken.mdb", error)) cout << "Rejected broken.mdb: " << error << endl;
+    {
+        // Valid header, but one interior string offset points far past the bytes
+        Table small("small");
+        small.addColumn(Column("name", "string", 0));
+        vector<string> row(1, "Ali");
+        for (int i = 0; i < 3; i++) small.insert(row);
+        saveBinary(small, "broken.mdb");
+        fstream f("broken.mdb", ios::in | ios::out | ios::binary);
+        ColumnDescriptor d;
+        f.seekg(sizeof(FileHeader));
+        f.read((char*)&d, sizeof(d));
+        uint32_t huge = 0x7FFFFFFF;
+        f.seekp((streamoff)(d.dataOffset + 4));
+        f.write((const char*)&huge, 4);
+    }
+    if (!broken.open("broken.mdb", error)) cout << "Rejected broken.mdb: " << error << endl;
+
+    remove("users.txt");
+    remove("users.mdb");
+    remove("broken.mdb");
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Why Text Loading Is Slow
+       - Every value goes through tokenizing + string -> int conversion
+       - LOAD time grows with the number of VALUES, not the number of bytes
+
+    2. Binary Layout = Memory Layout
+       - An int column on disk is exactly the int32 array used in memory
+       - Loading requires no conversion at all
+
+    3. mmap (Memory-Mapped Files)
+       - Maps the file into the address space, returns a pointer
+       - No read() copy: the page cache IS the table
+       - OS loads 4 KB pages lazily on first access (page fault)
+
+    4. Versioned Header
+       - Magic bytes identify the file type
+       - Version number allows future format changes
+       - Byte-order mark detects files written on a different-endian machine
+
+    5. Schema Block
+       - Fixed 64-byte descriptors: name, type, constraint bitmask, segment offsets
+       - Constraint bits are the same 1 | 2 | 4 flags as the text format
+
+    6. Aligned Segments
+       - Each column starts on a 64-byte boundary (cache line, SIMD friendly)
+       - alignUp uses bitwise AND with ~(64 - 1)
+
+    7. Safe Loading
+       - Every offset and size is bounds-checked before use
+       - Size math done without overflow; unknown column types rejected
+       - String offsets must rise monotonically and stay inside the bytes
+       - Save writes a .tmp file and renames it (never a half-written table)
+*/
@@ -0,0 +1,565 @@
+/*
+    5) WRITE-AHEAD LOG (WAL) + GROUP COMMIT + CHECKPOINT
+
+    Explanation:
+    - SAVE TO FILE (dbms.md) rewrites the WHOLE table -> O(table size) per change
+      and a crash in the middle of the rewrite destroys the only copy
+    - WAL: every INSERT / DELETE appends ONE small record to a log file
+      -> cost is O(record size), old data is never overwritten
+    - Durability = fsync. fsync is slow (~ms), so GROUP COMMIT lets one thread
+      flush the records of many waiting transactions with a single fsync
+    - Checkpoint: write a fresh base file (temp + rename), then empty the log
+    - LOAD: read base file, then REPLAY log records newer than the base file
+    - Torn writes (crash mid-append) are detected with a length + CRC32 check
+
+    POSIX only (open / write / fsync / ftruncate).
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+// ===== CRC32 (bitwise, table-driven) =====
+uint32_t crcTable[256];
+
+void initCrcTable() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        crcTable[i] = c;
+    }
+}
+
+uint32_t crc32(const char* data, size_t len) {
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) c = crcTable[(c ^ (unsigned char)data[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+// ===== TABLE (row model from the spec) =====
+class Row {
+public:
+    vector<string> values;
+};
+
+class Table {
+public:
+    string tableName;
+    vector<string> columnLines;   // "id int 3", "name string 2", ...
+    vector<Row*> rows;
+
+    Table(string name) : tableName(name) {}
+
+    ~Table() {
+        clear();
+    }
+
+    void clear() {
+        for (size_t i = 0; i < rows.size(); i++) delete rows[i];
+        rows.clear();
+    }
+
+    void insert(const vector<string>& values) {
+        Row* r = new Row();
+        r->values = values;
+        rows.push_back(r);
+    }
+
+    // DELETE FROM table WHERE <first column> = key
+    bool remove(const string& key) {
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i]->values[0] == key) {
+                delete rows[i];
+                rows[i] = rows.back();     // O(1) removal (row order not preserved)
+                rows.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// ===== LOG RECORD FORMAT =====
+//   [uint32 payloadLength][uint32 crc32(payload)][payload]
+//   payload = [uint64 lsn][uint8 type][uint16 valueCount]{[uint16 len][bytes]}...
+const uint8_t LOG_INSERT = 1;
+const uint8_t LOG_DELETE = 2;
+
+void putU16(string& s, uint16_t v) { s.append((const char*)&v, 2); }
+void putU32(string& s, uint32_t v) { s.append((const char*)&v, 4); }
+void putU64(string& s, uint64_t v) { s.append((const char*)&v, 8); }
+
+// Counts and lengths are 16-bit: the caller (logAndApply) rejects anything larger
+string encodeRecord(uint64_t lsn, uint8_t type, const vector<string>& values) {
+    string payload;
+    putU64(payload, lsn);
+    payload.push_back((char)type);
+    putU16(payload, (uint16_t)values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        putU16(payload, (uint16_t)values[i].size());
+        payload += values[i];
+    }
+    string record;
+    putU32(record, (uint32_t)payload.size());
+    putU32(record, crc32(payload.data(), payload.size()));
+    return record + payload;
+}
+
+// Returns bytes consumed, or 0 if the record is incomplete / corrupt.
+// A record that passes the CRC must still be well formed: a known type,
+// at least one value (DELETE exactly one: the key), no trailing bytes.
+size_t decodeRecord(const char* p, size_t avail, uint64_t& lsn, uint8_t& type, vector<string>& values) {
+    if (avail < 8) return 0;
+    uint32_t len, crc;
+    memcpy(&len, p, 4);
+    memcpy(&crc, p + 4, 4);
+    if (len < 11 || avail - 8 < len) return 0;
+    const char* q = p + 8;
+    if (crc32(q, len) != crc) return 0;
+
+    memcpy(&lsn, q, 8);
+    type = (uint8_t)q[8];
+    uint16_t count;
+    memcpy(&count, q + 9, 2);
+    size_t off = 11;
+    values.clear();
+    for (uint16_t i = 0; i < count; i++) {
+        if (off + 2 > len) return 0;
+        uint16_t vlen;
+        memcpy(&vlen, q + off, 2);
+        off += 2;
+        if (off + vlen > len) return 0;
+        values.push_back(string(q + off, vlen));
+        off += vlen;
+    }
+    if (off != len || count == 0) return 0;
+    if (type != LOG_INSERT && (type != LOG_DELETE || count != 1)) return 0;
+    return 8 + len;
+}
+
+// ===== DATABASE: table + WAL + group commit =====
+class Database {
+private:
+    Table table;
+    string baseFile;
+    string logFile;
+    int logFd;
+
+    mutex m;
+    condition_variable flushed;
+    string pendingBuffer;      // Records appended but not yet written
+    uint64_t nextLsn;          // LSN given to the next record
+    uint64_t durableLsn;       // All records <= durableLsn are on disk
+    uint64_t checkpointLsn;    // Records <= checkpointLsn are in the base file
+    bool flushInProgress;
+    bool logFailed;            // A write / fsync failed: nothing after it is durable
+    size_t fsyncCount;
+    size_t replayedCount;
+
+    // Leader: write everything pending with ONE write + ONE fsync.
+    // On any error durableLsn stays where it was and the log is marked failed,
+    // so no waiting writer is told its record is committed.
+    void flushAsLeader(unique_lock<mutex>& lock) {
+        flushInProgress = true;
+        string batch;
+        batch.swap(pendingBuffer);
+        uint64_t batchEnd = nextLsn - 1;
+
+        lock.unlock();                        // Other threads keep appending meanwhile
+        bool ok = true;
+        size_t written = 0;
+        while (written < batch.size()) {
+            ssize_t n = write(logFd, batch.data() + written, batch.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            written += (size_t)n;
+        }
+        if (ok) {
+            int rc;
+            do rc = fsync(logFd); while (rc != 0 && errno == EINTR);
+            ok = rc == 0;
+        }
+        lock.lock();
+
+        if (ok) {
+            durableLsn = batchEnd;
+            fsyncCount++;
+        } else {
+            cout << "Error: log write failed, records after LSN " << durableLsn << " are NOT durable" << endl;
+            logFailed = true;
+        }
+        flushInProgress = false;
+        flushed.notify_all();
+    }
+
+    // Append a record, apply it, and wait until it is durable (0 = not committed)
+    uint64_t logAndApply(uint8_t type, const vector<string>& values) {
+        unique_lock<mutex> lock(m);
+        if (logFd < 0 || logFailed) {
+            cout << "Error: " << (logFd < 0 ? "database is not loaded" : "log has failed, reload the database") << endl;
+            return 0;
+        }
+        // Record format stores counts and lengths in 16 bits: check BEFORE an LSN is used
+        if (values.empty() || values.size() > 0xFFFF) {
+            cout << "Error: record must have 1 to 65535 values" << endl;
+            return 0;
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            if (values[i].size() > 0xFFFF) {
+                cout << "Error: value " << i << " is " << values[i].size() << " bytes (max 65535)" << endl;
+                return 0;
+            }
+        }
+        uint64_t lsn = nextLsn++;
+        pendingBuffer += encodeRecord(lsn, type, values);
+        if (type == LOG_INSERT) table.insert(values);
+        else table.remove(values[0]);
+
+        // Group commit: wait for a leader, or become the leader
+        while (durableLsn < lsn && !logFailed) {
+            if (!flushInProgress) flushAsLeader(lock);
+            else flushed.wait(lock);
+        }
+        return durableLsn >= lsn ? lsn : 0;
+    }
+
+    // Temp file -> fsync -> rename -> fsync the directory (makes the rename durable)
+    bool writeBaseFile(uint64_t lsn) {
+        string tmp = baseFile + ".tmp";
+        {
+            ofstream out(tmp);
+            out << "TABLE " << table.tableName << "\n";
+            out << "LSN " << lsn << "\n";
+            for (size_t c = 0; c < table.columnLines.size(); c++) out << table.columnLines[c] << "\n";
+            out << "DATA\n";
+            for (size_t r = 0; r < table.rows.size(); r++) {
+                for (size_t c = 0; c < table.rows[r]->values.size(); c++) {
+                    if (c) out << " ";
+                    out << table.rows[r]->values[c];
+                }
+                out << "\n";
+            }
+            out.close();
+            if (!out) {
+                cout << "Error: cannot write " << tmp << endl;
+                return false;
+            }
+        }
+        int fd = open(tmp.c_str(), O_RDONLY);
+        if (fd < 0 || fsync(fd) != 0) {         // Base file durable BEFORE rename
+            cout << "Error: cannot fsync " << tmp << endl;
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        close(fd);
+        if (rename(tmp.c_str(), baseFile.c_str()) != 0) {   // Atomic replace
+            cout << "Error: cannot rename " << tmp << endl;
+            return false;
+        }
+        size_t slash = baseFile.find_last_of('/');
+        string dir = slash == string::npos ? "." : (slash == 0 ? "/" : baseFile.substr(0, slash));
+        int dirFd = open(dir.c_str(), O_RDONLY);
+        bool dirOk = dirFd >= 0 && fsync(dirFd) == 0;
+        if (dirFd >= 0) close(dirFd);
+        if (!dirOk) {
+            cout << "Error: cannot fsync directory " << dir << endl;
+            return false;
+        }
+        return true;
+    }
+
+public:
+    Database(string name, string base, string log)
+        : table(name), baseFile(base), logFile(log), logFd(-1), nextLsn(1),
+          durableLsn(0), checkpointLsn(0), flushInProgress(false), logFailed(false), fsyncCount(0),
+          replayedCount(0) {}
+
+    ~Database() {
+        if (logFd >= 0) close(logFd);
+    }
+
+    void defineColumn(const string& line) {
+        table.columnLines.push_back(line);
+    }
+
+    // LOAD: base file + replay of the log tail (false if the log cannot be opened)
+    bool load() {
+        table.clear();
+        ifstream in(baseFile);
+        if (in) {
+            string word, line;
+            in >> word >> table.tableName >> word >> checkpointLsn;
+            table.columnLines.clear();
+            getline(in, line);
+            while (getline(in, line) && line != "DATA") table.columnLines.push_back(line);
+            while (getline(in, line)) {
+                if (line.empty()) continue;
+                istringstream ss(line);
+                vector<string> values;
+                string v;
+                while (ss >> v) values.push_back(v);
+                table.insert(values);
+            }
+        }
+
+        // Replay: read the whole log, apply records newer than the checkpoint
+        ifstream logIn(logFile, ios::binary);
+        string log((istreambuf_iterator<char>(logIn)), istreambuf_iterator<char>());
+        size_t pos = 0;
+        replayedCount = 0;
+        uint64_t lastLsn = checkpointLsn;
+        uint64_t lsn;
+        uint8_t type;
+        vector<string> values;
+        while (pos < log.size()) {
+            size_t used = decodeRecord(log.data() + pos, log.size() - pos, lsn, type, values);
+            if (used == 0) break;               // Torn tail: stop here
+            pos += used;
+            if (lsn <= checkpointLsn) continue;
+            if (type == LOG_INSERT) table.insert(values);
+            else table.remove(values[0]);
+            lastLsn = lsn;
+            replayedCount++;
+        }
+
+        // Open for appending and cut off any torn tail
+        logFd = open(logFile.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (logFd < 0) {
+            cout << "Error: cannot open " << logFile << endl;
+            return false;
+        }
+        if (ftruncate(logFd, (off_t)pos) != 0) cout << "Warning: could not truncate log" << endl;
+        lseek(logFd, 0, SEEK_END);
+        nextLsn = lastLsn + 1;
+        durableLsn = lastLsn;
+        return true;
+    }
+
+    size_t replayedRecords() const {
+        return replayedCount;
+    }
+
+    // true once the change is durable
+    bool insert(const vector<string>& values) {
+        return logAndApply(LOG_INSERT, values) != 0;
+    }
+
+    bool remove(const string& key) {
+        return logAndApply(LOG_DELETE, vector<string>(1, key)) != 0;
+    }
+
+    // CHECKPOINT: compact log into the base file, then empty the log.
+    // The log is truncated ONLY after the base file is durably in place.
+    bool checkpoint() {
+        unique_lock<mutex> lock(m);
+        while (!logFailed && (flushInProgress || !pendingBuffer.empty())) {
+            if (!flushInProgress) flushAsLeader(lock);
+            else flushed.wait(lock);
+        }
+        if (logFd < 0 || logFailed) {
+            cout << "Error: checkpoint skipped, the log is not healthy" << endl;
+            return false;
+        }
+        if (!writeBaseFile(durableLsn)) {
+            cout << "Error: checkpoint failed, log kept" << endl;
+            return false;
+        }
+        checkpointLsn = durableLsn;
+        // Base file now holds everything; a failure below only leaves stale
+        // records that replay skips (lsn <= checkpointLsn)
+        if (ftruncate(logFd, 0) != 0 || lseek(logFd, 0, SEEK_SET) < 0 || fsync(logFd) != 0) {
+            cout << "Warning: could not empty the log (its records are already checkpointed)" << endl;
+        }
+        return true;
+    }
+
+    // Test helper: append half a record, like a crash in the middle of write()
+    void simulateTornWrite(const vector<string>& values) {
+        string rec = encodeRecord(nextLsn, LOG_INSERT, values);
+        if (write(logFd, rec.data(), rec.size() / 2) < 0) cout << "Warning: write failed" << endl;
+        fsync(logFd);
+    }
+
+    size_t rowCount() const {
+        return table.rows.size();
+    }
+
+    size_t fsyncs() const {
+        return fsyncCount;
+    }
+
+    long long sumColumn(size_t c) const {
+        long long sum = 0;
+        for (size_t r = 0; r < table.rows.size(); r++) sum += atoll(table.rows[r]->values[c].c_str());
+        return sum;
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    initCrcTable();
+    const string BASE = "users.db";
+    const string LOG = "users.wal";
+    remove(BASE.c_str());
+    remove(LOG.c_str());
+
+    cout << "===== SESSION 1: INSERT / DELETE through the WAL =====" << endl;
+    long long expectedSum = 0;
+    size_t expectedRows = 0;
+    {
+        Database db("users", BASE, LOG);
+        db.defineColumn("id int 3");
+        db.defineColumn("name string 2");
+        db.defineColumn("age int 0");
+        db.load();
+
+        db.insert({"1", "Ali", "20"});
+        db.insert({"2", "Sara", "21"});
+        db.insert({"3", "Omar", "22"});
+        db.remove("2");
+        cout << "Rows: " << db.rowCount() << ", fsyncs: " << db.fsyncs() << endl;
+
+        db.checkpoint();
+        cout << "Checkpoint written, log emptied." << endl;
+
+        // Many concurrent writers -> group commit shares fsyncs
+        const int THREADS = 8;
+        const int PER_THREAD = 500;
+        auto start = chrono::steady_clock::now();
+        vector<thread> writers;
+        for (int t = 0; t < THREADS; t++) {
+            writers.push_back(thread([&db, t]() {
+                for (int i = 0; i < PER_THREAD; i++) {
+                    int id = 1000 + t * PER_THREAD + i;
+                    db.insert({to_string(id), "user" + to_string(id), to_string(id % 50)});
+                }
+            }));
+        }
+        for (size_t t = 0; t < writers.size(); t++) writers[t].join();
+        double ms = millisecondsSince(start);
+
+        size_t commits = THREADS * PER_THREAD;
+        cout << "\n" << commits << " durable inserts from " << THREADS << " threads in " << ms << " ms" << endl;
+        cout << "fsync calls: " << db.fsyncs() << " (" << (double)commits / db.fsyncs()
+             << " transactions per fsync)" << endl;
+        cout << "Average cost per durable insert: " << ms * 1000.0 / commits << " us" << endl;
+
+        db.simulateTornWrite({"99999", "ghost", "1"});
+        cout << "\n*** CRASH *** (no checkpoint, half-written record at the end of the log)" << endl;
+        expectedRows = db.rowCount();
+        expectedSum = db.sumColumn(0);
+    }
+
+    cout << "\n===== SESSION 2: LOAD = base file + log replay =====" << endl;
+    {
+        Database db("users", BASE, LOG);
+        db.load();
+        cout << "Replayed " << db.replayedRecords() << " log records" << endl;
+        cout << "Rows after recovery: " << db.rowCount() << " (expected " << expectedRows << ")" << endl;
+        bool ok = db.rowCount() == expectedRows && db.sumColumn(0) == expectedSum;
+        cout << "Recovered state matches: " << (ok ? "YES" : "NO") << endl;
+
+        db.insert({"5000", "Zain", "30"});
+        db.checkpoint();
+        cout << "Post-recovery insert + checkpoint done." << endl;
+    }
+
+    cout << "\n===== MALFORMED RECORDS =====" << endl;
+    {
+        // Valid CRC, but a DELETE with no key / an unknown type: must not decode
+        uint64_t lsn;
+        uint8_t type;
+        vector<string> values;
+        string emptyDelete = encodeRecord(1, LOG_DELETE, vector<string>());
+        string unknownType = encodeRecord(2, 7, vector<string>(1, "1"));
+        bool rejected = decodeRecord(emptyDelete.data(), emptyDelete.size(), lsn, type, values) == 0 &&
+                        decodeRecord(unknownType.data(), unknownType.size(), lsn, type, values) == 0;
+        cout << "CRC-valid malformed records rejected: " << (rejected ? "YES" : "NO") << endl;
+
+        Database db("users", BASE, "missing_dir/users.wal");
+        bool loaded = db.load();
+        cout << "Load with an unopenable log: " << (loaded ? "loaded" : "refused") << endl;
+    }
+    {
+        // A value too long for the 16-bit length field is refused up front,
+        // so it can never corrupt the log and take later records with it
+        remove("big.db");
+        remove("big.wal");
+        {
+            Database db("big", "big.db", "big.wal");
+            db.load();
+            db.insert({"1", "Ali", "20"});
+            bool hugeAccepted = db.insert({"2", string(70000, 'x'), "21"});
+            db.insert({"3", "Omar", "22"});
+            cout << "70000-byte value: " << (hugeAccepted ? "accepted" : "rejected") << endl;
+        }
+        Database db("big", "big.db", "big.wal");
+        db.load();
+        cout << "Rows recovered after reload: " << db.rowCount() << " (expected 2)" << endl;
+        remove("big.db");
+        remove("big.wal");
+    }
+
+    remove(BASE.c_str());
+    remove(LOG.c_str());
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Write-Ahead Logging
+       - Log the change BEFORE acknowledging it
+       - Appending is sequential I/O and proportional to the change, not the table
+
+    2. Log Sequence Number (LSN)
+       - Every record gets an increasing number
+       - durableLsn: everything up to here is on disk
+       - checkpointLsn: everything up to here is already in the base file
+
+    3. Group Commit
+       - Threads append records to a shared buffer
+       - First waiting thread becomes the "leader": one write() + one fsync()
+       - All others sleep on a condition variable and are woken together
+       - fsync cost is shared by many transactions
+
+    4. Torn Write Detection
+       - Each record starts with its length and a CRC32 of its payload
+       - Replay stops at the first incomplete or corrupt record
+       - A CRC-valid record must also be well formed (known type, a key
+         for DELETE) before replay touches the table
+       - Values longer than 65535 bytes are rejected before logging: the
+         16-bit length field can never be truncated into a "torn" record
+       - A failed write / fsync never advances durableLsn: waiting writers
+         get false instead of a false commit
+       - The torn tail is truncated so new records append cleanly
+
+    5. Checkpointing
+       - Write full table to users.db.tmp, fsync, rename over users.db
+       - rename() is atomic: the old or the new file exists, never half of one
+       - fsync the directory so the rename itself survives a crash
+       - Only then is the log truncated (its records are now in the base file);
+         any failed step keeps the log untouched
+
+    6. Recovery
+       - LOAD reads the base file, then replays log records with lsn > checkpointLsn
+*/
@@ -0,0 +1,491 @@
+/*
+    6) MULTI-TABLE QUERIES: HASH JOIN + SORT-MERGE JOIN
+
+    Explanation:
+    - SELECT ... FROM a JOIN b ON a.x = b.y combines rows with equal keys
+    - Nested-loop join: for every row of a, scan all of b -> O(n * m)
+    - Hash join: build a hash table on the SMALLER input, probe with the larger
+      -> O(n + m)
+    - Radix-partitioned hash join: when the build side is too big for the CPU
+      cache, first split BOTH inputs into partitions by hash bits, then join
+      partition i of a with partition i of b (each hash table fits in cache)
+    - Sort-merge join: if both inputs are already sorted on the key,
+      walk them together like merging two sorted arrays -> O(n + m), no hash table
+*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// ===== TABLE (column-major, int and string columns) =====
+class Table {
+public:
+    string tableName;
+    vector<string> columnNames;
+    vector<bool> isIntColumn;
+    vector< vector<int> > ints;       // Used when isIntColumn[c]
+    vector< vector<string> > strings; // Used otherwise
+    size_t rowCount;
+
+    Table(string name) : tableName(name), rowCount(0) {}
+
+    void addColumn(const string& name, bool isInt) {
+        columnNames.push_back(name);
+        isIntColumn.push_back(isInt);
+        ints.push_back(vector<int>());
+        strings.push_back(vector<string>());
+    }
+
+    int findColumn(const string& name) const {
+        for (size_t c = 0; c < columnNames.size(); c++) {
+            if (columnNames[c] == name) return (int)c;
+        }
+        return -1;
+    }
+
+    string valueAt(int c, size_t r) const {
+        return isIntColumn[c] ? to_string(ints[c][r]) : strings[c][r];
+    }
+
+    // Checked once per query to decide if sort-merge join is possible
+    bool isSortedOn(int c) const {
+        for (size_t r = 1; r < rowCount; r++) {
+            if (ints[c][r - 1] > ints[c][r]) return false;
+        }
+        return true;
+    }
+};
+
+// ===== DATABASE: multi-table support =====
+class Database {
+private:
+    vector<Table*> tables;
+
+public:
+    ~Database() {
+        for (size_t i = 0; i < tables.size(); i++) delete tables[i];
+    }
+
+    Table* createTable(const string& name) {
+        Table* t = new Table(name);
+        tables.push_back(t);
+        return t;
+    }
+
+    Table* findTable(const string& name) const {
+        for (size_t i = 0; i < tables.size(); i++) {
+            if (tables[i]->tableName == name) return tables[i];
+        }
+        return nullptr;
+    }
+};
+
+// Join output: pairs of matching row ids (left, right)
+struct JoinResult {
+    vector<uint32_t> left;
+    vector<uint32_t> right;
+
+    void add(uint32_t l, uint32_t r) {
+        left.push_back(l);
+        right.push_back(r);
+    }
+
+    size_t size() const {
+        return left.size();
+    }
+};
+
+inline uint32_t hashKey(int key) {
+    uint32_t x = (uint32_t)key;
+    x ^= x >> 16; x *= 0x7feb352du;
+    x ^= x >> 15; x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// ===== 1) NESTED-LOOP JOIN (baseline) =====
+void nestedLoopJoin(const int* a, size_t na, const int* b, size_t nb, JoinResult& out) {
+    for (size_t i = 0; i < na; i++) {
+        for (size_t j = 0; j < nb; j++) {
+            if (a[i] == b[j]) out.add((uint32_t)i, (uint32_t)j);
+        }
+    }
+}
+
+// ===== 2) HASH JOIN (bucket-chained arrays) =====
+// head[bucket] = first build row in the bucket, next[row] = following row.
+// Two flat arrays instead of a node per entry -> no allocation per key.
+const uint32_t NONE = 0xFFFFFFFFu;
+
+struct BuildTable {
+    vector<uint32_t> head;
+    vector<uint32_t> next;
+    uint32_t mask;
+
+    void build(const int* keys, size_t n) {
+        size_t buckets = 1;
+        while (buckets < n * 2) buckets <<= 1;
+        head.assign(buckets, NONE);
+        next.assign(n, NONE);
+        mask = (uint32_t)(buckets - 1);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t b = hashKey(keys[i]) & mask;
+            next[i] = head[b];
+            head[b] = (uint32_t)i;
+        }
+    }
+};
+
+// probeIsLeft: true when the probe side is the query's left table
+void hashJoinRange(const int* buildKeys, const uint32_t* buildRows, size_t nb,
+                   const int* probeKeys, const uint32_t* probeRows, size_t np,
+                   bool probeIsLeft, BuildTable& ht, JoinResult& out) {
+    ht.build(buildKeys, nb);
+    for (size_t i = 0; i < np; i++) {
+        int key = probeKeys[i];
+        for (uint32_t j = ht.head[hashKey(key) & ht.mask]; j != NONE; j = ht.next[j]) {
+            if (buildKeys[j] == key) {
+                uint32_t p = probeRows ? probeRows[i] : (uint32_t)i;
+                uint32_t b = buildRows ? buildRows[j] : j;
+                if (probeIsLeft) out.add(p, b);
+                else out.add(b, p);
+            }
+        }
+    }
+}
+
+// ===== 3) RADIX PARTITIONING =====
+// Scatter (key, rowId) into 2^bits partitions using the TOP hash bits
+// (the bucket index inside a partition uses the LOW bits, so they stay independent)
+struct Partitioned {
+    vector<int> keys;
+    vector<uint32_t> rows;
+    vector<size_t> start;      // start[p] .. start[p+1] = partition p
+};
+
+void radixPartition(const int* keys, size_t n, int bits, Partitioned& out) {
+    size_t parts = (size_t)1 << bits;
+    int shift = 32 - bits;
+    vector<size_t> histogram(parts + 1, 0);
+
+    // Pass 1: count partition sizes
+    for (size_t i = 0; i < n; i++) histogram[(hashKey(keys[i]) >> shift) + 1]++;
+    // Prefix sum -> start offsets
+    for (size_t p = 0; p < parts; p++) histogram[p + 1] += histogram[p];
+    out.start = histogram;
+
+    // Pass 2: scatter
+    out.keys.resize(n);
+    out.rows.resize(n);
+    vector<size_t> cursor(histogram.begin(), histogram.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        size_t p = hashKey(keys[i]) >> shift;
+        size_t dst = cursor[p]++;
+        out.keys[dst] = keys[i];
+        out.rows[dst] = (uint32_t)i;
+    }
+}
+
+// Build side bigger than this (in rows) gets partitioned.
+// 64K rows * (4-byte key + 8 bytes of head/next) ~ 768 KB: roughly an L2 cache.
+const size_t PARTITION_THRESHOLD = 65536;
+
+string lastJoinMethod;
+
+void hashJoin(const int* a, size_t na, const int* b, size_t nb, JoinResult& out) {
+    // Build on the smaller side
+    bool buildIsLeft = na < nb;
+    const int* buildKeys = buildIsLeft ? a : b;
+    const int* probeKeys = buildIsLeft ? b : a;
+    size_t nBuild = buildIsLeft ? na : nb;
+    size_t nProbe = buildIsLeft ? nb : na;
+    BuildTable ht;
+
+    if (nBuild <= PARTITION_THRESHOLD) {
+        lastJoinMethod = "hash join (build on " + string(buildIsLeft ? "left" : "right") + ")";
+        hashJoinRange(buildKeys, nullptr, nBuild, probeKeys, nullptr, nProbe, !buildIsLeft, ht, out);
+        return;
+    }
+
+    // Choose enough partitions so each build partition is cache-sized
+    int bits = 1;
+    while ((nBuild >> bits) > PARTITION_THRESHOLD / 4 && bits < 14) bits++;
+    lastJoinMethod = "radix-partitioned hash join (" + to_string(1 << bits) + " partitions)";
+
+    Partitioned pb, pp;
+    radixPartition(buildKeys, nBuild, bits, pb);
+    radixPartition(probeKeys, nProbe, bits, pp);
+    for (size_t p = 0; p + 1 < pb.start.size(); p++) {
+        size_t bs = pb.start[p], be = pb.start[p + 1];
+        size_t ps = pp.start[p], pe = pp.start[p + 1];
+        if (bs == be || ps == pe) continue;
+        hashJoinRange(&pb.keys[bs], &pb.rows[bs], be - bs,
+                      &pp.keys[ps], &pp.rows[ps], pe - ps, !buildIsLeft, ht, out);
+    }
+}
+
+// ===== 4) SORT-MERGE JOIN (both inputs sorted on the key) =====
+void sortMergeJoin(const int* a, size_t na, const int* b, size_t nb, JoinResult& out) {
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else {
+            // Equal keys: emit the cross product of both runs of this key
+            int key = a[i];
+            size_t jStart = j;
+            while (i < na && a[i] == key) {
+                for (j = jStart; j < nb && b[j] == key; j++) out.add((uint32_t)i, (uint32_t)j);
+                i++;
+            }
+        }
+    }
+}
+
+// ===== QUERY: SELECT cols FROM a JOIN b ON a.x = b.y =====
+struct ColumnRef {
+    Table* table;
+    int column;
+};
+
+bool splitQualified(const string& s, string& table, string& column) {
+    size_t dot = s.find('.');
+    if (dot == string::npos) return false;
+    table = s.substr(0, dot);
+    column = s.substr(dot + 1);
+    return true;
+}
+
+// Returns number of result rows, or -1 on error. Prints up to maxPrint rows.
+long long executeJoinQuery(Database& db, const string& sql, size_t maxPrint) {
+    istringstream in(sql);
+    string word;
+    vector<string> selectList;
+    in >> word;                                   // SELECT
+    while (in >> word && word != "FROM") {
+        if (word.back() == ',') word.pop_back();
+        selectList.push_back(word);
+    }
+    string leftName, rightName, joinWord, onWord, lhs, eq, rhs;
+    in >> leftName >> joinWord >> rightName >> onWord >> lhs >> eq >> rhs;
+    if (joinWord != "JOIN" || onWord != "ON" || eq != "=") {
+        cout << "Error: Expected SELECT ... FROM a JOIN b ON a.x = b.y" << endl;
+        return -1;
+    }
+
+    Table* left = db.findTable(leftName);
+    Table* right = db.findTable(rightName);
+    if (!left || !right) {
+        cout << "Error: Unknown table!" << endl;
+        return -1;
+    }
+
+    string lt, lc, rt, rc;
+    if (!splitQualified(lhs, lt, lc) || !splitQualified(rhs, rt, rc)) {
+        cout << "Error: Join columns must be written as table.column" << endl;
+        return -1;
+    }
+    if (lt == rightName && rt == leftName) {      // ON b.y = a.x
+        swap(lt, rt);
+        swap(lc, rc);
+    }
+    int lk = left->findColumn(lc);
+    int rk = right->findColumn(rc);
+    if (lt != leftName || rt != rightName || lk < 0 || rk < 0 ||
+        !left->isIntColumn[lk] || !right->isIntColumn[rk]) {
+        cout << "Error: Join keys must be int columns of the joined tables" << endl;
+        return -1;
+    }
+
+    // Projection list
+    vector<ColumnRef> projection;
+    for (size_t i = 0; i < selectList.size(); i++) {
+        string t, c;
+        if (selectList[i] == "*") {
+            for (size_t k = 0; k < left->columnNames.size(); k++) projection.push_back({left, (int)k});
+            for (size_t k = 0; k < right->columnNames.size(); k++) projection.push_back({right, (int)k});
+            continue;
+        }
+        if (!splitQualified(selectList[i], t, c)) return -1;
+        Table* tab = (t == leftName) ? left : (t == rightName ? right : nullptr);
+        if (!tab || tab->findColumn(c) < 0) {
+            cout << "Error: Unknown column " << selectList[i] << endl;
+            return -1;
+        }
+        projection.push_back({tab, tab->findColumn(c)});
+    }
+
+    // Plan: sort-merge if both sides are already sorted, else hash join
+    const int* a = left->ints[lk].data();
+    const int* b = right->ints[rk].data();
+    JoinResult result;
+    if (left->isSortedOn(lk) && right->isSortedOn(rk)) {
+        lastJoinMethod = "sort-merge join (both inputs sorted)";
+        sortMergeJoin(a, left->rowCount, b, right->rowCount, result);
+    } else {
+        hashJoin(a, left->rowCount, b, right->rowCount, result);
+    }
+
+    cout << "Plan: " << lastJoinMethod << endl;
+    for (size_t p = 0; p < projection.size(); p++) {
+        cout << projection[p].table->tableName << "." << projection[p].table->columnNames[projection[p].column] << "\t";
+    }
+    cout << endl;
+    for (size_t r = 0; r < result.size() && r < maxPrint; r++) {
+        for (size_t p = 0; p < projection.size(); p++) {
+            uint32_t row = (projection[p].table == left) ? result.left[r] : result.right[r];
+            cout << projection[p].table->valueAt(projection[p].column, row) << "\t";
+        }
+        cout << endl;
+    }
+    if (result.size() > maxPrint) cout << "... (" << result.size() << " rows)" << endl;
+    return (long long)result.size();
+}
+
+// Order-independent checksum of a join result, to compare algorithms
+unsigned long long checksum(const JoinResult& r) {
+    unsigned long long s = 0;
+    for (size_t i = 0; i < r.size(); i++) s += ((unsigned long long)r.left[i] << 32 | r.right[i]) * 0x9E3779B97F4A7C15ULL;
+    return s;
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    Database db;
+
+    cout << "===== CREATE TABLES =====" << endl;
+    Table* users = db.createTable("users");
+    users->addColumn("id", true);
+    users->addColumn("name", false);
+    Table* orders = db.createTable("orders");
+    orders->addColumn("id", true);
+    orders->addColumn("user_id", true);
+    orders->addColumn("amount", true);
+
+    const char* names[] = {"Ali", "Sara", "Omar"};
+    for (int i = 0; i < 3; i++) {
+        users->ints[0].push_back(i + 1);
+        users->strings[1].push_back(names[i]);
+        users->rowCount++;
+    }
+    int orderUsers[] = {2, 1, 2, 3, 5};
+    for (int i = 0; i < 5; i++) {
+        orders->ints[1].push_back(orderUsers[i]);
+        orders->ints[0].push_back(100 + i);
+        orders->ints[2].push_back(250 * (i + 1));
+        orders->rowCount++;
+    }
+
+    cout << "\n===== SELECT users.name, orders.amount FROM users JOIN orders ON users.id = orders.user_id =====" << endl;
+    executeJoinQuery(db, "SELECT users.name, orders.amount FROM users JOIN orders ON users.id = orders.user_id", 10);
+
+    cout << "\n===== FACT x DIMENSION: 5M sales JOIN 1000 products =====" << endl;
+    const size_t FACT = 5000000, DIM = 1000;
+    Table* products = db.createTable("products");
+    products->addColumn("id", true);
+    products->addColumn("name", false);
+    for (size_t i = 0; i < DIM; i++) {
+        products->ints[0].push_back((int)((i * 7919) % DIM));     // Unsorted keys
+        products->strings[1].push_back("product" + to_string(i));
+        products->rowCount++;
+    }
+    Table* sales = db.createTable("sales");
+    sales->addColumn("product_id", true);
+    sales->addColumn("qty", true);
+    unsigned seed = 7;
+    for (size_t i = 0; i < FACT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        sales->ints[0].push_back((int)((seed >> 8) % (DIM + 100)));   // Some ids have no product
+        sales->ints[1].push_back(1 + (int)(seed % 5));
+        sales->rowCount++;
+    }
+    auto start = chrono::steady_clock::now();
+    executeJoinQuery(db, "SELECT products.name, sales.qty FROM sales JOIN products ON sales.product_id = products.id", 3);
+    cout << "Time: " << millisecondsSince(start) << " ms" << endl;
+
+    // Nested loop on a slice only (the full join would take minutes)
+    const size_t SLICE = 50000;
+    JoinResult nl, hj;
+    start = chrono::steady_clock::now();
+    nestedLoopJoin(sales->ints[0].data(), SLICE, products->ints[0].data(), DIM, nl);
+    double nlMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    hashJoin(sales->ints[0].data(), SLICE, products->ints[0].data(), DIM, hj);
+    double hjMs = millisecondsSince(start);
+    cout << "First " << SLICE << " sales: nested loop " << nlMs << " ms, hash join " << hjMs << " ms, results "
+         << (checksum(nl) == checksum(hj) && nl.size() == hj.size() ? "match" : "DIFFER") << endl;
+
+    cout << "\n===== LARGE x LARGE: radix partitioning vs plain hash join =====" << endl;
+    const size_t BIG = 2000000;
+    vector<int> keysA(BIG), keysB(BIG);
+    for (size_t i = 0; i < BIG; i++) {
+        seed = seed * 1103515245u + 12345u;
+        keysA[i] = (int)((seed >> 8) % (BIG * 2));
+        seed = seed * 1103515245u + 12345u;
+        keysB[i] = (int)((seed >> 8) % (BIG * 2));
+    }
+    JoinResult plain, radix;
+    BuildTable ht;
+    start = chrono::steady_clock::now();
+    hashJoinRange(keysA.data(), nullptr, BIG, keysB.data(), nullptr, BIG, true, ht, plain);
+    double plainMs = millisecondsSince(start);
+    start = chrono::steady_clock::now();
+    hashJoin(keysB.data(), BIG, keysA.data(), BIG, radix);
+    double radixMs = millisecondsSince(start);
+    cout << "Plain hash join : " << plain.size() << " rows in " << plainMs << " ms" << endl;
+    cout << lastJoinMethod << " : " << radix.size() << " rows in " << radixMs << " ms" << endl;
+    cout << "Results " << (checksum(plain) == checksum(radix) ? "match" : "DIFFER") << endl;
+
+    cout << "\n===== SORTED INPUTS: sort-merge join =====" << endl;
+    Table* s1 = db.createTable("events");
+    s1->addColumn("day", true);
+    Table* s2 = db.createTable("calendar");
+    s2->addColumn("day", true);
+    s2->addColumn("label", false);
+    for (int d = 0; d < 365; d++) {
+        for (int k = 0; k < 3; k++) { s1->ints[0].push_back(d); s1->rowCount++; }
+        s2->ints[0].push_back(d);
+        s2->strings[1].push_back("day" + to_string(d));
+        s2->rowCount++;
+    }
+    executeJoinQuery(db, "SELECT calendar.label, events.day FROM events JOIN calendar ON events.day = calendar.day", 4);
+
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Nested-Loop Join
+       - Compare every pair of rows -> n * m comparisons
+       - 5M x 1000 = 5 billion comparisons
+
+    2. Hash Join
+       - Build phase: insert the smaller table's keys into a hash table
+       - Probe phase: look up each key of the larger table -> O(1) each
+       - head[] / next[] arrays: chained buckets without per-node allocation
+
+    3. Radix Partitioning
+       - Random probes into a hash table larger than the cache miss on almost every access
+       - Pass 1 counts rows per partition (histogram), prefix sum gives start offsets
+       - Pass 2 scatters rows to their partition (top hash bits, via >> shift)
+       - Partition i of A only joins partition i of B: small, cache-resident tables
+
+    4. Sort-Merge Join
+       - Both inputs sorted: advance the pointer with the smaller key
+       - Equal keys: emit all pairs of the two runs
+       - No hash table at all; ideal when data is already ordered (e.g. by an index)
+
+    5. Query Planning
+       - Sorted on the key?         -> sort-merge join
+       - Small build side?          -> plain hash join
+       - Large build side?          -> radix-partitioned hash join
+*/
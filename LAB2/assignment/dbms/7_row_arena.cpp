@@ -0,0 +1,325 @@
+/*
+    7) ARENA-ALLOCATED ROW STORAGE (Bulk Free)
+
+    Explanation:
+    - Spec: every Row created with new, every Row freed with delete in ~Table()
+      -> a Row with vector<string> costs 1 (Row) + 1 (vector buffer) + 1 per long string
+         malloc calls, and the same number of free calls at shutdown
+    - Arena (region / bump allocator):
+      -> ask the system for BIG chunks (1 MB)
+      -> each allocation just moves a pointer forward inside the current chunk
+      -> rows end up next to each other in memory (good for scans)
+      -> ~Table() frees the whole arena: one delete[] per CHUNK, not per row
+    - Rows are still dynamically allocated, just from our own allocator
+    - Arena tracks bytes in use, so every table can report its memory
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+using namespace std;
+
+// ===== ARENA ALLOCATOR =====
+class Arena {
+private:
+    vector<char*> chunks;
+    char* current;            // Next free byte in the newest chunk
+    size_t remaining;         // Free bytes left in the newest chunk
+    size_t chunkSize;
+    size_t bytesUsed;         // Sum of all allocation sizes
+    size_t bytesReserved;     // Sum of all chunk sizes
+
+    void newChunk(size_t minSize) {
+        size_t size = minSize > chunkSize ? minSize : chunkSize;
+        char* chunk = new char[size];
+        chunks.push_back(chunk);
+        current = chunk;
+        remaining = size;
+        bytesReserved += size;
+    }
+
+public:
+    Arena(size_t chunkBytes = 1 << 20)
+        : current(nullptr), remaining(0), chunkSize(chunkBytes), bytesUsed(0), bytesReserved(0) {}
+
+    // Bulk free: O(number of chunks)
+    ~Arena() {
+        release();
+    }
+
+    // Copying an arena would double-free its chunks
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Bump allocation: align, then move the pointer forward
+    void* allocate(size_t size, size_t align = alignof(max_align_t)) {
+        size_t padding = (align - ((uintptr_t)current & (align - 1))) & (align - 1);
+        if (padding + size > remaining) {
+            newChunk(size + align);
+            padding = (align - ((uintptr_t)current & (align - 1))) & (align - 1);
+        }
+        char* p = current + padding;
+        current += padding + size;
+        remaining -= padding + size;
+        bytesUsed += size;
+        return p;
+    }
+
+    void release() {
+        for (size_t i = 0; i < chunks.size(); i++) delete[] chunks[i];
+        chunks.clear();
+        current = nullptr;
+        remaining = 0;
+        bytesUsed = 0;
+        bytesReserved = 0;
+    }
+
+    void swap(Arena& other) {
+        std::swap(chunks, other.chunks);
+        std::swap(current, other.current);
+        std::swap(remaining, other.remaining);
+        std::swap(chunkSize, other.chunkSize);
+        std::swap(bytesUsed, other.bytesUsed);
+        std::swap(bytesReserved, other.bytesReserved);
+    }
+
+    size_t used() const { return bytesUsed; }
+    size_t reserved() const { return bytesReserved; }
+    size_t chunkCount() const { return chunks.size(); }
+};
+
+// ===== ROW: lives entirely inside the arena =====
+// Values are (pointer, length) views into arena bytes.
+// Row has NO destructor work: nothing inside it owns heap memory.
+struct Value {
+    const char* data;
+    uint32_t length;
+
+    string str() const {
+        return string(data, length);
+    }
+};
+
+class Row {
+public:
+    uint32_t count;
+    Value* values;            // Array of 'count' values, also in the arena
+
+    // Placement: allocate Row + value array + characters from the arena
+    static Row* create(Arena& arena, const vector<string>& input) {
+        Row* row = new (arena.allocate(sizeof(Row), alignof(Row))) Row();
+        row->count = (uint32_t)input.size();
+        row->values = (Value*)arena.allocate(sizeof(Value) * input.size(), alignof(Value));
+        for (size_t i = 0; i < input.size(); i++) {
+            char* chars = (char*)arena.allocate(input[i].size(), 1);
+            memcpy(chars, input[i].data(), input[i].size());
+            row->values[i].data = chars;
+            row->values[i].length = (uint32_t)input[i].size();
+        }
+        return row;
+    }
+
+    size_t footprint() const {
+        size_t bytes = sizeof(Row) + count * sizeof(Value);
+        for (uint32_t i = 0; i < count; i++) bytes += values[i].length;
+        return bytes;
+    }
+};
+
+// ===== TABLE: still vector<Row*>, rows come from the arena =====
+class Table {
+private:
+    string tableName;
+    vector<string> columns;
+    vector<Row*> rows;
+    Arena arena;
+    size_t deadBytes;         // Space held by deleted rows until compact()
+
+public:
+    Table(string name) : tableName(name), deadBytes(0) {}
+
+    // Frees every row at once (chunks), no per-row delete
+    ~Table() {
+        rows.clear();
+    }
+
+    void addColumn(const string& name) {
+        columns.push_back(name);
+    }
+
+    bool insert(const vector<string>& values) {
+        if (values.size() != columns.size()) return false;
+        rows.push_back(Row::create(arena, values));
+        return true;
+    }
+
+    // DELETE WHERE first column = key: the row's bytes become dead space
+    bool remove(const string& key) {
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i]->values[0].length == key.size() &&
+                memcmp(rows[i]->values[0].data, key.data(), key.size()) == 0) {
+                deadBytes += rows[i]->footprint();
+                rows[i] = rows.back();
+                rows.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Copy live rows into a fresh arena, then drop the old one in bulk
+    void compact() {
+        Arena fresh;
+        vector<string> values;
+        for (size_t i = 0; i < rows.size(); i++) {
+            values.clear();
+            for (uint32_t c = 0; c < rows[i]->count; c++) values.push_back(rows[i]->values[c].str());
+            rows[i] = Row::create(fresh, values);
+        }
+        arena.swap(fresh);        // 'fresh' now holds the old chunks and frees them
+        deadBytes = 0;
+    }
+
+    void selectAll(size_t limit) const {
+        for (size_t c = 0; c < columns.size(); c++) cout << columns[c] << "\t";
+        cout << endl;
+        for (size_t r = 0; r < rows.size() && r < limit; r++) {
+            for (uint32_t c = 0; c < rows[r]->count; c++) cout << rows[r]->values[c].str() << "\t";
+            cout << endl;
+        }
+    }
+
+    void printMemory() const {
+        cout << tableName << ": " << rows.size() << " rows, "
+             << arena.used() << " bytes in use, "
+             << arena.reserved() << " bytes reserved in "
+             << arena.chunkCount() << " chunk(s), "
+             << deadBytes << " bytes dead" << endl;
+    }
+
+    size_t bytesInUse() const {
+        return arena.used() - deadBytes;
+    }
+};
+
+// ===== BASELINE: spec model, one new/delete per Row =====
+class HeapRow {
+public:
+    vector<string> values;
+};
+
+class HeapTable {
+public:
+    vector<HeapRow*> rows;
+
+    ~HeapTable() {
+        for (size_t i = 0; i < rows.size(); i++) delete rows[i];
+    }
+
+    void insert(const vector<string>& values) {
+        HeapRow* r = new HeapRow();
+        r->values = values;
+        rows.push_back(r);
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== SMALL TABLE =====" << endl;
+    Table users("users");
+    users.addColumn("id");
+    users.addColumn("name");
+    users.addColumn("email");
+    users.insert({"1", "Ali", "ali.khan@university.edu.pk"});
+    users.insert({"2", "Sara", "sara.ahmed@university.edu.pk"});
+    users.insert({"3", "Omar", "omar.farooq@university.edu.pk"});
+    users.selectAll(10);
+    users.printMemory();
+
+    cout << "\n===== DELETE + COMPACT =====" << endl;
+    users.remove("2");
+    users.printMemory();
+    users.compact();
+    users.printMemory();
+    users.selectAll(10);
+
+    cout << "\n===== 2M ROWS: new/delete per row vs arena =====" << endl;
+    const size_t N = 2000000;
+    vector<string> values(3);
+
+    double heapInsert, heapFree, arenaInsert, arenaFree;
+    {
+        auto start = chrono::steady_clock::now();
+        HeapTable* heap = new HeapTable();
+        heap->rows.reserve(N);
+        for (size_t i = 0; i < N; i++) {
+            values[0] = to_string(i);
+            values[1] = "user" + to_string(i % 1000);
+            values[2] = "user" + to_string(i) + "@university.edu.pk";
+            heap->insert(values);
+        }
+        heapInsert = millisecondsSince(start);
+        start = chrono::steady_clock::now();
+        delete heap;
+        heapFree = millisecondsSince(start);
+    }
+    {
+        auto start = chrono::steady_clock::now();
+        Table* table = new Table("big_users");
+        table->addColumn("id");
+        table->addColumn("name");
+        table->addColumn("email");
+        for (size_t i = 0; i < N; i++) {
+            values[0] = to_string(i);
+            values[1] = "user" + to_string(i % 1000);
+            values[2] = "user" + to_string(i) + "@university.edu.pk";
+            table->insert(values);
+        }
+        arenaInsert = millisecondsSince(start);
+        table->printMemory();
+        cout << "Bytes per row: " << table->bytesInUse() / N << endl;
+        start = chrono::steady_clock::now();
+        delete table;
+        arenaFree = millisecondsSince(start);
+    }
+
+    cout << "\nInsert   : heap " << heapInsert << " ms, arena " << arenaInsert << " ms" << endl;
+    cout << "Teardown : heap " << heapFree << " ms, arena " << arenaFree << " ms" << endl;
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Cost of new/delete per Row
+       - Each malloc/free searches free lists, takes locks, touches headers
+       - Millions of rows -> millions of calls at insert AND at shutdown
+       - Rows end up scattered across the heap
+
+    2. Arena (Bump) Allocation
+       - allocate(): align pointer, advance it, done (a few instructions)
+       - New 1 MB chunk only when the current one is full
+       - Rows and their characters are packed back to back
+
+    3. Alignment With Bitwise Math
+       - padding = (align - (address & (align - 1))) & (align - 1)
+       - Works because alignments are powers of two
+
+    4. Bulk Free
+       - ~Arena() deletes each CHUNK: 2M rows in ~100 chunks -> ~100 delete[] calls
+       - Row has no destructor work (values are views into the arena)
+
+    5. Deletes and Compaction
+       - Arena cannot free one row; deleted bytes become "dead"
+       - compact() copies live rows into a new arena and drops the old one at once
+
+    6. Memory Reporting
+       - used(): bytes handed out, reserved(): bytes taken from the system
+*/
@@ -0,0 +1,545 @@
+/*
+    8) PARALLEL MORSEL-DRIVEN SCAN + AGGREGATION
+
+    Explanation:
+    - SELECT over a big table on ONE thread leaves every other core idle
+    - Morsel: a small fixed-size range of rows (16K rows)
+    - Work-stealing pool: each worker has its own deque of morsels;
+      when it runs out it STEALS from another worker's deque
+      -> fast workers automatically take more morsels (no idle cores at the end)
+    - The workers are started ONCE, when the pool is built, and then sleep
+      until the next query arrives: a query costs no thread creation
+    - Each worker filters + projects + aggregates into its OWN partial result
+      (thread-local: no locks, no shared cache lines while scanning)
+    - At the end the partial results are MERGED into the final answer
+
+    Queries supported by this demo (any int columns, chosen at run time):
+        SELECT <group>, COUNT(*), SUM(<value>), MIN(<value>), MAX(<value>), AVG(<value>)
+        FROM <table> [WHERE <column> <op> <constant>] GROUP BY <group>
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+using namespace std;
+
+// ===== TABLE (column-major int columns) =====
+class Table {
+public:
+    string tableName;
+    vector<string> columnNames;
+    vector< vector<int> > columns;
+
+    Table(string name) : tableName(name) {}
+
+    // Returns the new column's index
+    size_t addColumn(const string& name, size_t rows) {
+        columnNames.push_back(name);
+        columns.push_back(vector<int>(rows));
+        return columns.size() - 1;
+    }
+
+    // -1 if there is no such column
+    int columnIndex(const string& name) const {
+        for (size_t c = 0; c < columnNames.size(); c++) {
+            if (columnNames[c] == name) return (int)c;
+        }
+        return -1;
+    }
+
+    size_t size() const {
+        return columns.empty() ? 0 : columns[0].size();
+    }
+};
+
+// ===== MORSEL =====
+const size_t MORSEL_SIZE = 16384;
+
+struct Morsel {
+    size_t begin;
+    size_t end;
+};
+
+// ===== WORK-STEALING THREAD POOL =====
+// Owner pops from the FRONT of its deque, thieves steal from the BACK
+// (they take work the owner would reach last, so they rarely collide).
+// Workers live as long as the pool: run() hands them a job and waits.
+class WorkStealingPool {
+private:
+    struct WorkerQueue {
+        mutex m;
+        deque<Morsel> tasks;
+    };
+
+    vector<WorkerQueue*> queues;
+    vector<thread> workers;
+    size_t workerCount;
+
+    // Current job, guarded by jobMutex
+    mutex jobMutex;
+    condition_variable jobReady;      // Workers wait here between queries
+    condition_variable jobDone;       // run() waits here for the last worker
+    function<void(size_t, Morsel)> job;
+    size_t generation;                // Bumped once per run()
+    size_t finished;                  // Workers done with the current job
+    bool stopping;
+
+    bool popLocal(size_t w, Morsel& out) {
+        lock_guard<mutex> lock(queues[w]->m);
+        if (queues[w]->tasks.empty()) return false;
+        out = queues[w]->tasks.front();
+        queues[w]->tasks.pop_front();
+        return true;
+    }
+
+    bool steal(size_t thief, Morsel& out) {
+        for (size_t k = 1; k < workerCount; k++) {
+            size_t victim = (thief + k) % workerCount;
+            lock_guard<mutex> lock(queues[victim]->m);
+            if (!queues[victim]->tasks.empty()) {
+                out = queues[victim]->tasks.back();
+                queues[victim]->tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t w) {
+        size_t seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(jobMutex);
+                jobReady.wait(lock, [&]() { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            Morsel m;
+            while (true) {
+                if (popLocal(w, m)) {
+                    job(w, m);
+                } else if (steal(w, m)) {
+                    steals++;
+                    job(w, m);
+                } else {
+                    break;                              // All deques empty
+                }
+            }
+            lock_guard<mutex> lock(jobMutex);
+            if (++finished == workerCount) jobDone.notify_all();
+        }
+    }
+
+public:
+    atomic<size_t> steals;
+
+    WorkStealingPool(size_t count)
+        : workerCount(count), generation(0), finished(0), stopping(false), steals(0) {
+        for (size_t w = 0; w < workerCount; w++) queues.push_back(new WorkerQueue());
+        for (size_t w = 0; w < workerCount; w++) workers.push_back(thread([this, w]() { workerLoop(w); }));
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        for (size_t w = 0; w < workers.size(); w++) workers[w].join();
+        for (size_t w = 0; w < queues.size(); w++) delete queues[w];
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const {
+        return workerCount;
+    }
+
+    // Split [0, rows) into morsels, hand out contiguous blocks of them,
+    // run body(workerId, morsel) until every morsel is processed.
+    // One query at a time: run() returns only when the job is complete.
+    template <typename Body>
+    void run(size_t rows, Body body) {
+        size_t morsels = (rows + MORSEL_SIZE - 1) / MORSEL_SIZE;
+        for (size_t i = 0; i < morsels; i++) {
+            size_t w = i * workerCount / morsels;      // Contiguous ranges per worker
+            size_t end = (i + 1) * MORSEL_SIZE < rows ? (i + 1) * MORSEL_SIZE : rows;
+            queues[w]->tasks.push_back(Morsel{i * MORSEL_SIZE, end});
+        }
+
+        unique_lock<mutex> lock(jobMutex);
+        job = [&body](size_t w, Morsel m) { body(w, m); };
+        finished = 0;
+        generation++;
+        jobReady.notify_all();
+        jobDone.wait(lock, [&]() { return finished == workerCount; });
+        job = nullptr;
+    }
+};
+
+// ===== AGGREGATE STATE =====
+struct AggState {
+    long long count;
+    long long sum;
+    int minValue;
+    int maxValue;
+
+    AggState() : count(0), sum(0), minValue(INT_MAX), maxValue(INT_MIN) {}
+
+    void add(int v) {
+        count++;
+        sum += v;
+        if (v < minValue) minValue = v;
+        if (v > maxValue) maxValue = v;
+    }
+
+    void merge(const AggState& o) {
+        count += o.count;
+        sum += o.sum;
+        if (o.minValue < minValue) minValue = o.minValue;
+        if (o.maxValue > maxValue) maxValue = o.maxValue;
+    }
+
+    double avg() const {
+        return count ? (double)sum / count : 0.0;
+    }
+};
+
+// ===== GROUP BY HASH TABLE (open addressing, one per thread) =====
+class GroupTable {
+private:
+    vector<int> keys;
+    vector<bool> used;
+    vector<AggState> states;
+    size_t mask;
+    size_t groups;
+
+    size_t slotFor(int key) {
+        size_t slot = ((uint32_t)key * 2654435761u) & mask;
+        while (used[slot] && keys[slot] != key) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow() {
+        vector<int> oldKeys;
+        vector<bool> oldUsed;
+        vector<AggState> oldStates;
+        oldKeys.swap(keys);
+        oldUsed.swap(used);
+        oldStates.swap(states);
+        init((mask + 1) * 2);
+        for (size_t i = 0; i < oldKeys.size(); i++) {
+            if (oldUsed[i]) at(oldKeys[i]).merge(oldStates[i]);
+        }
+    }
+
+    void init(size_t capacity) {
+        keys.assign(capacity, 0);
+        used.assign(capacity, false);
+        states.assign(capacity, AggState());
+        mask = capacity - 1;
+        groups = 0;
+    }
+
+public:
+    GroupTable() {
+        init(64);
+    }
+
+    AggState& at(int key) {
+        size_t slot = slotFor(key);
+        if (!used[slot]) {
+            if ((groups + 1) * 2 > mask + 1) {
+                grow();
+                slot = slotFor(key);
+            }
+            used[slot] = true;
+            keys[slot] = key;
+            groups++;
+        }
+        return states[slot];
+    }
+
+    void mergeInto(GroupTable& target) const {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (used[i]) target.at(keys[i]).merge(states[i]);
+        }
+    }
+
+    // Sorted output for printing / comparing
+    vector< pair<int, AggState> > sortedGroups() const {
+        vector< pair<int, AggState> > out;
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (used[i]) out.push_back(make_pair(keys[i], states[i]));
+        }
+        for (size_t i = 1; i < out.size(); i++) {         // Insertion sort (few groups)
+            pair<int, AggState> x = out[i];
+            size_t j = i;
+            while (j > 0 && out[j - 1].first > x.first) { out[j] = out[j - 1]; j--; }
+            out[j] = x;
+        }
+        return out;
+    }
+};
+
+// Thread-local partial result, padded to its own cache lines
+struct alignas(64) Partial {
+    GroupTable groups;
+    AggState total;
+};
+
+// ===== QUERY =====
+enum CompareOp { OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE };
+
+struct AggQuery {
+    string groupColumn;       // GROUP BY
+    string valueColumn;       // COUNT / SUM / MIN / MAX / AVG over this column
+    bool hasWhere;
+    string whereColumn;       // WHERE whereColumn op whereValue
+    CompareOp op;
+    int whereValue;
+
+    AggQuery(string group, string value)
+        : groupColumn(group), valueColumn(value), hasWhere(false), op(OP_GT), whereValue(0) {}
+
+    AggQuery& where(string column, CompareOp o, int v) {
+        hasWhere = true;
+        whereColumn = column;
+        op = o;
+        whereValue = v;
+        return *this;
+    }
+
+    string sql(const string& table) const {
+        static const char* opText[] = {"=", "<>", "<", "<=", ">", ">="};
+        string s = "SELECT " + groupColumn + ", COUNT(*), SUM(" + valueColumn + "), MIN(" + valueColumn +
+                   "), MAX(" + valueColumn + "), AVG(" + valueColumn + ") FROM " + table;
+        if (hasWhere) s += " WHERE " + whereColumn + " " + opText[op] + " " + to_string(whereValue);
+        return s + " GROUP BY " + groupColumn;
+    }
+};
+
+// Predicates as small function objects: the compiler inlines each one
+// into its own copy of the scan loop (no switch per row)
+struct Always { bool operator()(int) const { return true; } };
+struct Eq { int c; bool operator()(int x) const { return x == c; } };
+struct Ne { int c; bool operator()(int x) const { return x != c; } };
+struct Lt { int c; bool operator()(int x) const { return x < c; } };
+struct Le { int c; bool operator()(int x) const { return x <= c; } };
+struct Gt { int c; bool operator()(int x) const { return x > c; } };
+struct Ge { int c; bool operator()(int x) const { return x >= c; } };
+
+template <typename Pred>
+void scanMorsel(const int* group, const int* filter, const int* value, Pred pred, Morsel m, Partial& local) {
+    for (size_t r = m.begin; r < m.end; r++) {
+        if (pred(filter[r])) {                                // WHERE
+            local.groups.at(group[r]).add(value[r]);          // GROUP BY + aggregates
+            local.total.add(value[r]);
+        }
+    }
+}
+
+// ===== PARALLEL QUERY =====
+// Column names are resolved once, before any worker starts.
+// Unknown column -> error, nothing is scanned.
+bool groupByParallel(const Table& t, const AggQuery& q, WorkStealingPool& pool, GroupTable& result, AggState& total) {
+    int g = t.columnIndex(q.groupColumn);
+    int v = t.columnIndex(q.valueColumn);
+    int f = q.hasWhere ? t.columnIndex(q.whereColumn) : v;    // No WHERE: Always ignores it
+    const string& missing = g < 0 ? q.groupColumn : v < 0 ? q.valueColumn : q.whereColumn;
+    if (g < 0 || v < 0 || f < 0) {
+        cout << "Error: table " << t.tableName << " has no column " << missing << endl;
+        return false;
+    }
+    const int* group = t.columns[g].data();
+    const int* value = t.columns[v].data();
+    const int* filter = t.columns[f].data();
+    vector<Partial> partials(pool.size());
+
+    pool.run(t.size(), [&](size_t worker, Morsel m) {
+        Partial& local = partials[worker];
+        int c = q.whereValue;
+        if (!q.hasWhere) { scanMorsel(group, filter, value, Always(), m, local); return; }
+        switch (q.op) {
+            case OP_EQ: scanMorsel(group, filter, value, Eq{c}, m, local); break;
+            case OP_NE: scanMorsel(group, filter, value, Ne{c}, m, local); break;
+            case OP_LT: scanMorsel(group, filter, value, Lt{c}, m, local); break;
+            case OP_LE: scanMorsel(group, filter, value, Le{c}, m, local); break;
+            case OP_GT: scanMorsel(group, filter, value, Gt{c}, m, local); break;
+            case OP_GE: scanMorsel(group, filter, value, Ge{c}, m, local); break;
+        }
+    });
+
+    // Merge phase: combine thread-local results
+    result = GroupTable();
+    total = AggState();
+    for (size_t w = 0; w < partials.size(); w++) {
+        partials[w].groups.mergeInto(result);
+        total.merge(partials[w].total);
+    }
+    return true;
+}
+
+bool sameResult(const GroupTable& a, const GroupTable& b) {
+    vector< pair<int, AggState> > x = a.sortedGroups(), y = b.sortedGroups();
+    if (x.size() != y.size()) return false;
+    for (size_t i = 0; i < x.size(); i++) {
+        if (x[i].first != y[i].first || x[i].second.count != y[i].second.count ||
+            x[i].second.sum != y[i].second.sum || x[i].second.minValue != y[i].second.minValue ||
+            x[i].second.maxValue != y[i].second.maxValue) return false;
+    }
+    return true;
+}
+
+void printResult(const AggQuery& q, const GroupTable& groups, const AggState& total) {
+    cout << q.groupColumn << "\tCOUNT\tSUM\t\tMIN\tMAX\tAVG" << endl;
+    vector< pair<int, AggState> > rows = groups.sortedGroups();
+    for (size_t i = 0; i < rows.size(); i++) {
+        const AggState& s = rows[i].second;
+        cout << rows[i].first << "\t" << s.count << "\t" << s.sum << "\t" << s.minValue
+             << "\t" << s.maxValue << "\t" << fixed << setprecision(1) << s.avg() << endl;
+        cout.unsetf(ios::fixed);
+    }
+    cout << "ALL\t" << total.count << "\t" << total.sum << "\t" << total.minValue
+         << "\t" << total.maxValue << "\t" << fixed << setprecision(1) << total.avg() << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const size_t N = 20000000;
+    cout << "===== Building employees table (" << N << " rows) =====" << endl;
+    Table employees("employees");
+    size_t deptCol = employees.addColumn("dept", N);
+    size_t ageCol = employees.addColumn("age", N);
+    size_t salaryCol = employees.addColumn("salary", N);
+    unsigned seed = 42;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        employees.columns[deptCol][i] = (int)((seed >> 8) % 12);
+        employees.columns[ageCol][i] = 20 + (int)((seed >> 4) % 45);
+        employees.columns[salaryCol][i] = 30000 + (int)((seed >> 12) % 90000);
+    }
+
+    size_t cores = thread::hardware_concurrency();
+    if (cores == 0) cores = 4;
+    cout << "Hardware threads: " << cores << endl;
+
+    AggQuery mainQuery = AggQuery("dept", "salary").where("age", OP_GT, 30);
+    cout << "\n" << mainQuery.sql(employees.tableName) << endl;
+
+    // Reference run: one worker
+    WorkStealingPool single(1);
+    GroupTable reference;
+    AggState singleTotal;
+    auto start = chrono::steady_clock::now();
+    groupByParallel(employees, mainQuery, single, reference, singleTotal);
+    double singleMs = millisecondsSince(start);
+
+    // Scaling runs (each pool's threads are started when it is built, outside the timing)
+    cout << "\nThreads\tTime(ms)\tSpeedup\tSteals\tSame result" << endl;
+    cout << 1 << "\t" << singleMs << "\t\t1.00\t0\tYES" << endl;
+    for (size_t threads = 2; threads <= 64 && (threads <= cores * 2 || threads <= 8); threads *= 2) {
+        WorkStealingPool pool(threads);
+        GroupTable last;
+        AggState total;
+        start = chrono::steady_clock::now();
+        groupByParallel(employees, mainQuery, pool, last, total);
+        double ms = millisecondsSince(start);
+        cout << threads << "\t" << ms << "\t\t" << fixed << setprecision(2) << singleMs / ms
+             << "\t" << pool.steals.load() << "\t"
+             << (sameResult(reference, last) && total.sum == singleTotal.sum ? "YES" : "NO") << endl;
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+
+    cout << "\n===== RESULT =====" << endl;
+    printResult(mainQuery, reference, singleTotal);
+
+    cout << "\n===== MORE QUERIES ON ONE POOL (threads started once) =====" << endl;
+    WorkStealingPool pool(cores < 4 ? 4 : cores);
+    vector<AggQuery> queries;
+    queries.push_back(AggQuery("age", "salary").where("dept", OP_EQ, 3));
+    queries.push_back(AggQuery("dept", "age").where("salary", OP_GE, 100000));
+    queries.push_back(AggQuery("dept", "salary"));
+    for (size_t i = 0; i < queries.size(); i++) {
+        GroupTable groups, check;
+        AggState total, checkTotal;
+        start = chrono::steady_clock::now();
+        groupByParallel(employees, queries[i], pool, groups, total);
+        double ms = millisecondsSince(start);
+        groupByParallel(employees, queries[i], single, check, checkTotal);
+        cout << queries[i].sql(employees.tableName) << endl;
+        cout << "  " << pool.size() << " workers, " << ms << " ms, " << groups.sortedGroups().size()
+             << " groups, same as 1 worker: " << (sameResult(groups, check) && total.sum == checkTotal.sum ? "YES" : "NO") << endl;
+    }
+    cout << "\nAge statistics per dept, salary >= 100000:" << endl;
+    {
+        GroupTable groups;
+        AggState total;
+        groupByParallel(employees, queries[1], pool, groups, total);
+        printResult(queries[1], groups, total);
+    }
+
+    cout << "\n===== UNKNOWN COLUMN =====" << endl;
+    GroupTable none;
+    AggState noneTotal;
+    bool ran = groupByParallel(employees, AggQuery("dept", "bonus"), pool, none, noneTotal);
+    cout << "Query rejected: " << (!ran ? "YES" : "NO") << endl;
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Morsel-Driven Execution
+       - Table split into small row ranges (morsels)
+       - Workers pull morsels until none are left
+       - Small morsels = good load balance, big enough to amortize scheduling
+
+    2. Work Stealing
+       - Each worker owns a deque: pops from the front
+       - Idle worker steals from the back of another deque
+       - No central queue that every thread fights over
+
+    3. Persistent Workers
+       - Threads are created in the pool's constructor and joined in its destructor
+       - Between queries they sleep on a condition variable (no busy waiting)
+       - run(): queue the morsels, bump the job generation, wake everyone,
+         wait until the last worker reports done
+
+    4. Thread-Local Partial Aggregates
+       - COUNT, SUM, MIN, MAX per group are updated without any locking
+       - alignas(64) keeps each worker's state on its own cache lines (no false sharing)
+       - AVG = SUM / COUNT is computed only at the end
+
+    5. Merge Phase
+       - Partial results are combined: counts and sums add, min/max compare
+       - Cost is (threads x groups), tiny compared to the scan
+
+    6. Query Parameters
+       - GROUP BY column, aggregated column and WHERE (column, op, constant)
+         are chosen at run time; names resolve to column pointers once
+       - Each comparison is its own function object, so the scan loop is
+         compiled once per operator with no switch inside the loop
+       - Unknown column: error before any row is read
+
+    7. Scaling
+       - The scan is read-only and every worker writes only its own state
+       - Throughput grows with cores until memory bandwidth is saturated
+*/
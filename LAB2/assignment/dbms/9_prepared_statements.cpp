@@ -0,0 +1,661 @@
+/*
+    9) QUERY PARSER + PREPARED STATEMENTS + PLAN CACHE
+
+    Explanation:
+    - Spec: each command is read into char buffer[256] and parsed from scratch,
+      so a million identical-shaped INSERTs are tokenized, parsed and validated
+      a million times
+    - Pipeline used here:
+        text -> TOKENIZER -> tokens -> PARSER -> AST -> COMPILER -> Plan -> EXECUTE
+    - Plan: AST already checked against the schema (table found, column count
+      and types resolved). Executing a plan only binds parameter values.
+    - PREPARE name AS <statement with ?>  -> compile once
+      EXECUTE name (v1, v2, ...)          -> bind + run, no parsing
+    - Plan cache: literals in ordinary statements are replaced by ? (normalized text)
+      so "VALUES (1, Ali, 20)" and "VALUES (2, Sara, 21)" share ONE cached plan.
+      Least-recently-used plans are evicted when the cache is full (LRU).
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+// ===== TOKENIZER =====
+enum TokenType { T_IDENT, T_NUMBER, T_STRING, T_SYMBOL, T_PARAM, T_END };
+
+struct Token {
+    TokenType type;
+    string text;
+};
+
+bool tokenize(const char* s, vector<Token>& out, string& error) {
+    out.clear();
+    size_t i = 0;
+    while (s[i]) {
+        char c = s[i];
+        if (isspace((unsigned char)c)) { i++; continue; }
+        size_t start = i;
+        if (isalpha((unsigned char)c) || c == '_') {
+            while (isalnum((unsigned char)s[i]) || s[i] == '_' || s[i] == '@' || s[i] == '.') i++;
+            out.push_back({T_IDENT, string(s + start, i - start)});
+        } else if (isdigit((unsigned char)c) || (c == '-' && isdigit((unsigned char)s[i + 1]))) {
+            i++;
+            while (isdigit((unsigned char)s[i])) i++;
+            out.push_back({T_NUMBER, string(s + start, i - start)});
+        } else if (c == '\'') {
+            i++;
+            while (s[i] && s[i] != '\'') i++;
+            if (!s[i]) { error = "unterminated string"; return false; }
+            out.push_back({T_STRING, string(s + start + 1, i - start - 1)});
+            i++;
+        } else if (c == '?') {
+            out.push_back({T_PARAM, "?"});
+            i++;
+        } else if (c == '<' || c == '>' || c == '!') {
+            i++;
+            if (s[i] == '=') i++;
+            out.push_back({T_SYMBOL, string(s + start, i - start)});
+        } else if (strchr("(),*=;", c)) {
+            out.push_back({T_SYMBOL, string(1, c)});
+            i++;
+        } else {
+            error = string("unexpected character '") + c + "'";
+            return false;
+        }
+    }
+    out.push_back({T_END, ""});
+    return true;
+}
+
+bool isKeyword(const Token& t, const char* kw) {
+    if (t.type != T_IDENT || t.text.size() != strlen(kw)) return false;
+    for (size_t i = 0; i < t.text.size(); i++) {
+        if (toupper((unsigned char)t.text[i]) != kw[i]) return false;
+    }
+    return true;
+}
+
+// ===== NORMALIZATION (for the plan cache) =====
+// Replaces literal VALUES and WHERE constants by ?, collects them as parameters,
+// uppercases keywords. Result is the cache key.
+const char* KEYWORDS[] = {"SELECT", "FROM", "WHERE", "INSERT", "INTO", "VALUES", "CREATE", "TABLE"};
+
+void normalize(vector<Token>& tokens, vector<string>& literals, string& key) {
+    key.clear();
+    literals.clear();
+    bool inValues = false;
+    for (size_t i = 0; i + 1 < tokens.size(); i++) {
+        Token& t = tokens[i];
+        bool literal = false;
+        if (t.type == T_NUMBER || t.type == T_STRING) literal = true;
+        else if (inValues && t.type == T_IDENT) literal = true;          // VALUES (1, Ali, 20)
+        else if (i > 0 && t.type == T_IDENT && tokens[i - 1].type == T_SYMBOL &&
+                 tokens[i - 1].text != "(" && tokens[i - 1].text != "," && tokens[i - 1].text != "*") {
+            literal = true;                                              // WHERE name = Ali
+        }
+
+        if (isKeyword(t, "VALUES")) inValues = true;
+        if (t.type == T_SYMBOL && t.text == ")") inValues = false;
+
+        if (literal) {
+            literals.push_back(t.text);
+            t.type = T_PARAM;
+            t.text = "?";
+        }
+        for (size_t k = 0; k < sizeof(KEYWORDS) / sizeof(KEYWORDS[0]); k++) {
+            if (isKeyword(t, KEYWORDS[k])) t.text = KEYWORDS[k];
+        }
+        if (!key.empty()) key += ' ';
+        key += t.text;
+    }
+}
+
+// ===== AST =====
+struct Expr {
+    bool isParam;
+    int paramIndex;      // Position of the ? in the statement
+    string literal;
+
+    Expr() : isParam(false), paramIndex(-1) {}
+};
+
+struct ColumnDef {
+    string name;
+    string type;
+    unsigned int constraints;
+};
+
+enum StatementKind { S_CREATE, S_INSERT, S_SELECT, S_PREPARE, S_EXECUTE };
+
+struct Statement {
+    StatementKind kind;
+    string table;
+    vector<ColumnDef> columns;     // CREATE
+    vector<Expr> values;           // INSERT
+    bool hasWhere;                 // SELECT
+    string whereColumn;
+    string whereOp;
+    Expr whereValue;
+    string name;                   // PREPARE / EXECUTE
+    size_t bodyStart;              // PREPARE: token index where the inner statement starts
+    vector<string> args;           // EXECUTE
+    int paramCount;
+
+    Statement() : kind(S_SELECT), hasWhere(false), bodyStart(0), paramCount(0) {}
+};
+
+// ===== PARSER (recursive descent) =====
+class Parser {
+private:
+    const vector<Token>& tokens;
+    size_t pos;
+    int params;
+
+    const Token& peek() const { return tokens[pos]; }
+    const Token& next() { return tokens[pos++]; }
+
+    bool expectKeyword(const char* kw, string& error) {
+        if (!isKeyword(peek(), kw)) { error = string("expected ") + kw; return false; }
+        pos++;
+        return true;
+    }
+
+    bool expectSymbol(const char* sym, string& error) {
+        if (peek().type != T_SYMBOL || peek().text != sym) { error = string("expected '") + sym + "'"; return false; }
+        pos++;
+        return true;
+    }
+
+    bool identifier(string& out, string& error) {
+        if (peek().type != T_IDENT) { error = "expected identifier"; return false; }
+        out = next().text;
+        return true;
+    }
+
+    bool value(Expr& e, string& error) {
+        if (peek().type == T_END) { error = "unexpected end of statement"; return false; }   // Never read past T_END
+        const Token& t = next();
+        e.isParam = (t.type == T_PARAM);
+        e.paramIndex = e.isParam ? params++ : -1;
+        e.literal = t.text;
+        if (t.type == T_PARAM || t.type == T_NUMBER || t.type == T_STRING || t.type == T_IDENT) return true;
+        error = "expected value";
+        return false;
+    }
+
+    bool parseCreate(Statement& s, string& error) {
+        s.kind = S_CREATE;
+        if (!expectKeyword("TABLE", error) || !identifier(s.table, error)) return false;
+        if (peek().text != "(") return true;       // CREATE TABLE users (no columns yet)
+        pos++;
+        do {
+            ColumnDef d;
+            if (!identifier(d.name, error) || !identifier(d.type, error)) return false;
+            if (d.type != "int" && d.type != "string") { error = "type must be int or string"; return false; }
+            d.constraints = 0;
+            if (peek().type == T_NUMBER || peek().type == T_PARAM) d.constraints = (unsigned)atoi(next().text.c_str());
+            s.columns.push_back(d);
+        } while (peek().text == "," && next().type == T_SYMBOL);
+        return expectSymbol(")", error);
+    }
+
+    bool parseInsert(Statement& s, string& error) {
+        s.kind = S_INSERT;
+        if (!expectKeyword("INTO", error) || !identifier(s.table, error) ||
+            !expectKeyword("VALUES", error) || !expectSymbol("(", error)) return false;
+        do {
+            Expr e;
+            if (!value(e, error)) return false;
+            s.values.push_back(e);
+        } while (peek().text == "," && next().type == T_SYMBOL);
+        return expectSymbol(")", error);
+    }
+
+    bool parseSelect(Statement& s, string& error) {
+        s.kind = S_SELECT;
+        s.hasWhere = false;
+        if (!expectSymbol("*", error) || !expectKeyword("FROM", error) || !identifier(s.table, error)) return false;
+        if (isKeyword(peek(), "WHERE")) {
+            pos++;
+            s.hasWhere = true;
+            if (!identifier(s.whereColumn, error)) return false;
+            if (peek().type != T_SYMBOL) { error = "expected comparison"; return false; }
+            s.whereOp = next().text;
+            if (!value(s.whereValue, error)) return false;
+        }
+        return true;
+    }
+
+public:
+    Parser(const vector<Token>& t, size_t start = 0) : tokens(t), pos(start), params(0) {}
+
+    bool parse(Statement& s, string& error) {
+        bool ok;
+        if (isKeyword(peek(), "CREATE")) { pos++; ok = parseCreate(s, error); }
+        else if (isKeyword(peek(), "INSERT")) { pos++; ok = parseInsert(s, error); }
+        else if (isKeyword(peek(), "SELECT")) { pos++; ok = parseSelect(s, error); }
+        else if (isKeyword(peek(), "PREPARE")) {
+            pos++;
+            s.kind = S_PREPARE;
+            if (!identifier(s.name, error) || !expectKeyword("AS", error)) return false;
+            s.bodyStart = pos;
+            return true;
+        } else if (isKeyword(peek(), "EXECUTE")) {
+            pos++;
+            s.kind = S_EXECUTE;
+            if (!identifier(s.name, error)) return false;
+            if (peek().text == "(") {
+                pos++;
+                do {
+                    Expr arg;
+                    if (!value(arg, error)) return false;                   // Stops at T_END, rejects symbols
+                    if (arg.isParam) { error = "EXECUTE arguments must be values, not ?"; return false; }
+                    s.args.push_back(arg.literal);
+                } while (peek().text == "," && next().type == T_SYMBOL);
+                if (!expectSymbol(")", error)) return false;
+            }
+            ok = true;
+        } else {
+            error = "unknown command '" + peek().text + "'";
+            return false;
+        }
+        if (!ok) return false;
+        if (peek().text == ";") pos++;
+        if (peek().type != T_END) { error = "unexpected '" + peek().text + "'"; return false; }
+        s.paramCount = params;
+        return true;
+    }
+};
+
+// ===== STORAGE (row model from the spec) =====
+class Row {
+public:
+    vector<string> values;
+};
+
+class Table {
+public:
+    string tableName;
+    vector<ColumnDef> columns;
+    vector<Row*> rows;
+
+    Table(string name) : tableName(name) {}
+
+    ~Table() {
+        for (size_t i = 0; i < rows.size(); i++) delete rows[i];
+    }
+
+    int findColumn(const string& name) const {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (columns[c].name == name) return (int)c;
+        }
+        return -1;
+    }
+};
+
+// ===== PLAN: AST resolved against the schema =====
+struct Plan {
+    StatementKind kind;
+    Table* table;
+    vector<Expr> values;           // INSERT values (literals pre-validated)
+    int whereColumn;               // SELECT: -1 when no WHERE
+    string whereOp;
+    Expr whereValue;
+    int paramCount;
+
+    Plan() : kind(S_SELECT), table(nullptr), whereColumn(-1), paramCount(0) {}
+};
+
+bool isIntText(const string& s) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    strtol(s.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+bool compareValues(const string& a, const string& op, const string& b, bool numeric) {
+    int cmp;
+    if (numeric) {
+        long x = atol(a.c_str()), y = atol(b.c_str());
+        cmp = (x < y) ? -1 : (x > y ? 1 : 0);
+    } else {
+        cmp = a.compare(b);
+    }
+    if (op == "=") return cmp == 0;
+    if (op == "!=") return cmp != 0;
+    if (op == "<") return cmp < 0;
+    if (op == "<=") return cmp <= 0;
+    if (op == ">") return cmp > 0;
+    if (op == ">=") return cmp >= 0;
+    return false;
+}
+
+// ===== LRU PLAN CACHE =====
+// list keeps recency order (front = most recent), map gives O(1) lookup.
+class PlanCache {
+private:
+    struct Entry {
+        string key;
+        Plan plan;
+    };
+    list<Entry> order;
+    unordered_map<string, list<Entry>::iterator> index;
+    size_t capacity;
+
+public:
+    size_t hits, misses, evictions;
+
+    PlanCache(size_t cap) : capacity(cap), hits(0), misses(0), evictions(0) {}
+
+    Plan* find(const string& key) {
+        unordered_map<string, list<Entry>::iterator>::iterator it = index.find(key);
+        if (it == index.end()) { misses++; return nullptr; }
+        order.splice(order.begin(), order, it->second);      // Move to front
+        hits++;
+        return &it->second->plan;
+    }
+
+    Plan* insert(const string& key, const Plan& plan) {
+        if (order.size() >= capacity) {
+            index.erase(order.back().key);                    // Evict least recently used
+            order.pop_back();
+            evictions++;
+        }
+        order.push_front(Entry{key, plan});
+        index[key] = order.begin();
+        return &order.front().plan;
+    }
+
+    void clear() {
+        order.clear();
+        index.clear();
+    }
+};
+
+// ===== DATABASE =====
+class Database {
+private:
+    vector<Table*> tables;
+    PlanCache cache;
+    vector< pair<string, Plan> > prepared;   // PREPARE name -> compiled plan
+
+    // Scratch buffers reused by every run() (no per-statement reallocation)
+    vector<Token> tokens;
+    vector<string> literals;
+    string key;
+
+    Table* findTable(const string& name) const {
+        for (size_t i = 0; i < tables.size(); i++) {
+            if (tables[i]->tableName == name) return tables[i];
+        }
+        return nullptr;
+    }
+
+    // AST -> Plan: all schema checks happen here, ONCE per plan
+    bool compile(const Statement& s, Plan& p, string& error) {
+        p.kind = s.kind;
+        p.paramCount = s.paramCount;
+        p.whereColumn = -1;
+        p.table = findTable(s.table);
+        if (!p.table) { error = "table '" + s.table + "' does not exist"; return false; }
+
+        if (s.kind == S_INSERT) {
+            if (s.values.size() != p.table->columns.size()) {
+                error = "expected " + to_string(p.table->columns.size()) + " values";
+                return false;
+            }
+            for (size_t c = 0; c < s.values.size(); c++) {
+                if (!s.values[c].isParam && p.table->columns[c].type == "int" && !isIntText(s.values[c].literal)) {
+                    error = p.table->columns[c].name + " must be int";
+                    return false;
+                }
+            }
+            p.values = s.values;
+        } else if (s.kind == S_SELECT && s.hasWhere) {
+            p.whereColumn = p.table->findColumn(s.whereColumn);
+            if (p.whereColumn < 0) { error = "unknown column '" + s.whereColumn + "'"; return false; }
+            p.whereOp = s.whereOp;
+            p.whereValue = s.whereValue;
+        }
+        return true;
+    }
+
+    const string& bind(const Expr& e, const vector<string>& params) const {
+        return e.isParam ? params[e.paramIndex] : e.literal;
+    }
+
+    // Plan + parameters -> result. No tokenizing, no parsing.
+    bool execute(const Plan& p, const vector<string>& params, bool verbose, string& error) {
+        if ((int)params.size() != p.paramCount) {
+            error = "expected " + to_string(p.paramCount) + " parameters";
+            return false;
+        }
+        Table* t = p.table;
+        if (p.kind == S_INSERT) {
+            Row* row = new Row();
+            row->values.resize(p.values.size());
+            for (size_t c = 0; c < p.values.size(); c++) {
+                const string& v = bind(p.values[c], params);
+                // Only parameters need a runtime type check (literals were checked at compile)
+                if ((t->columns[c].constraints & 2) && v.empty()) { delete row; error = t->columns[c].name + " cannot be NULL"; return false; }
+                if (p.values[c].isParam && t->columns[c].type == "int" && !isIntText(v)) {
+                    delete row;
+                    error = t->columns[c].name + " must be int";
+                    return false;
+                }
+                row->values[c] = v;
+            }
+            t->rows.push_back(row);
+            if (verbose) cout << "Record inserted." << endl;
+        } else if (p.kind == S_SELECT) {
+            for (size_t c = 0; c < t->columns.size(); c++) cout << t->columns[c].name << "\t";
+            cout << endl;
+            bool numeric = p.whereColumn >= 0 && t->columns[p.whereColumn].type == "int";
+            for (size_t r = 0; r < t->rows.size(); r++) {
+                if (p.whereColumn >= 0 &&
+                    !compareValues(t->rows[r]->values[p.whereColumn], p.whereOp, bind(p.whereValue, params), numeric)) continue;
+                for (size_t c = 0; c < t->columns.size(); c++) cout << t->rows[r]->values[c] << "\t";
+                cout << endl;
+            }
+        }
+        return true;
+    }
+
+public:
+    bool useCache;
+
+    Database(size_t cacheSize) : cache(cacheSize), useCache(true) {}
+
+    ~Database() {
+        for (size_t i = 0; i < tables.size(); i++) delete tables[i];
+    }
+
+    bool run(const char* sql, bool verbose = true) {
+        string error;
+        if (!tokenize(sql, tokens, error)) return fail(error, verbose);
+
+        // DDL and PREPARE/EXECUTE bypass the literal-normalizing cache
+        if (isKeyword(tokens[0], "CREATE") || isKeyword(tokens[0], "PREPARE") || isKeyword(tokens[0], "EXECUTE")) {
+            Statement s;
+            if (!Parser(tokens).parse(s, error)) return fail(error, verbose);
+            return runUncached(s, tokens, verbose);
+        }
+
+        normalize(tokens, literals, key);
+
+        Plan* plan = useCache ? cache.find(key) : nullptr;
+        Plan compiled;
+        if (!plan) {
+            Statement s;
+            if (!Parser(tokens).parse(s, error)) return fail(error, verbose);
+            if (!compile(s, compiled, error)) return fail(error, verbose);
+            plan = useCache ? cache.insert(key, compiled) : &compiled;
+        }
+        if (!execute(*plan, literals, verbose, error)) return fail(error, verbose);
+        return true;
+    }
+
+    bool runUncached(const Statement& s, const vector<Token>& stmtTokens, bool verbose) {
+        string error;
+        if (s.kind == S_CREATE) {
+            if (findTable(s.table)) return fail("table already exists", verbose);
+            Table* t = new Table(s.table);
+            t->columns = s.columns;
+            tables.push_back(t);
+            cache.clear();                                   // Schema changed
+            if (verbose) cout << "Table created successfully." << endl;
+            return true;
+        }
+        if (s.kind == S_PREPARE) {
+            Statement inner;
+            Plan p;
+            if (!Parser(stmtTokens, s.bodyStart).parse(inner, error)) return fail(error, verbose);
+            if (!compile(inner, p, error)) return fail(error, verbose);
+            for (size_t i = 0; i < prepared.size(); i++) {
+                if (prepared[i].first == s.name) { prepared[i].second = p; return true; }
+            }
+            prepared.push_back(make_pair(s.name, p));
+            if (verbose) cout << "Prepared '" << s.name << "' (" << p.paramCount << " parameters)." << endl;
+            return true;
+        }
+        // EXECUTE
+        for (size_t i = 0; i < prepared.size(); i++) {
+            if (prepared[i].first == s.name) {
+                if (!execute(prepared[i].second, s.args, verbose, error)) return fail(error, verbose);
+                return true;
+            }
+        }
+        return fail("no prepared statement '" + s.name + "'", verbose);
+    }
+
+    // Fastest path: caller already has the argument values
+    bool executePrepared(const string& name, const vector<string>& args) {
+        string error;
+        for (size_t i = 0; i < prepared.size(); i++) {
+            if (prepared[i].first == name) return execute(prepared[i].second, args, false, error);
+        }
+        return false;
+    }
+
+    bool fail(const string& error, bool verbose) {
+        if (verbose) cout << "Error: " << error << endl;
+        return false;
+    }
+
+    void printCacheStats() const {
+        cout << "Plan cache: " << cache.hits << " hits, " << cache.misses << " misses, "
+             << cache.evictions << " evictions" << endl;
+    }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    Database db(64);
+
+    cout << "===== SQL SESSION =====" << endl;
+    const char* script[] = {
+        "CREATE TABLE users (id int 3, name string 2, age int 0)",
+        "INSERT INTO users VALUES (1, Ali, 20)",
+        "INSERT INTO users VALUES (2, Sara, 21)",
+        "INSERT INTO users VALUES (3, 'Omar Khan', 22)",
+        "INSERT INTO users VALUES (x, Bad, 1)",            // Type error
+        "INSERT INTO users VALUES (4, Hina)",              // Column count error
+        "SELECT * FROM users WHERE age > 20",
+        "PREPARE add_user AS INSERT INTO users VALUES (?, ?, ?)",
+        "EXECUTE add_user (5, Bilal, 30)",
+        "EXECUTE add_user (6, Ayesha)",                    // Wrong parameter count
+        "EXECUTE add_user (",                              // Unterminated argument list
+        "EXECUTE add_user (7,",
+        "EXECUTE add_user (7, *, 20)",                     // Symbol is not a value
+        "SELECT * FROM users",
+        "DROP TABLE users"                                 // Unsupported
+    };
+    char buffer[256];                                      // Spec: fixed-size query buffer
+    for (size_t i = 0; i < sizeof(script) / sizeof(script[0]); i++) {
+        strncpy(buffer, script[i], sizeof(buffer) - 1);
+        buffer[sizeof(buffer) - 1] = '\0';
+        cout << "\n> " << buffer << endl;
+        db.run(buffer);
+    }
+    cout << endl;
+    db.printCacheStats();
+
+    cout << "\n===== 500K INSERTs: three ways =====" << endl;
+    const size_t N = 500000;
+    Database bench(64);
+    bench.run("CREATE TABLE log (id int 1, name string 0, age int 0)", false);
+    bench.run("PREPARE ins AS INSERT INTO log VALUES (?, ?, ?)", false);
+
+    bench.useCache = false;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        snprintf(buffer, sizeof(buffer), "INSERT INTO log VALUES (%zu, user%zu, %zu)", i, i % 100, i % 60);
+        bench.run(buffer, false);
+    }
+    double parseMs = millisecondsSince(start);
+
+    bench.useCache = true;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        snprintf(buffer, sizeof(buffer), "INSERT INTO log VALUES (%zu, user%zu, %zu)", i, i % 100, i % 60);
+        bench.run(buffer, false);
+    }
+    double cacheMs = millisecondsSince(start);
+
+    vector<string> args(3);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        args[0] = to_string(i);
+        args[1] = "user" + to_string(i % 100);
+        args[2] = to_string(i % 60);
+        bench.executePrepared("ins", args);
+    }
+    double preparedMs = millisecondsSince(start);
+
+    cout << "Parse + compile every time : " << parseMs << " ms" << endl;
+    cout << "Normalized plan cache      : " << cacheMs << " ms" << endl;
+    cout << "Prepared statement         : " << preparedMs << " ms" << endl;
+    bench.printCacheStats();
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Tokenizer
+       - Turns characters into tokens: identifiers, numbers, 'strings', symbols, ?
+       - Parser then works on tokens, never on raw characters
+
+    2. Parser and AST
+       - Recursive descent: one function per statement type
+       - Output is a Statement (the Abstract Syntax Tree), not an action
+
+    3. Compiling to a Plan
+       - Table lookup, column count and literal types are checked ONCE
+       - Plan keeps only what execution needs
+
+    4. Prepared Statements
+       - PREPARE compiles "INSERT INTO users VALUES (?, ?, ?)" once
+       - EXECUTE binds values to the ? slots: no parsing, no schema lookup
+       - Parameters are type-checked at bind time (they were unknown at compile time)
+
+    5. Normalized Plan Cache
+       - Literals are replaced by ? -> many statements share one cache key
+       - Cache hit skips parsing and compiling
+
+    6. LRU Eviction
+       - list keeps plans in recency order, hash map points into the list
+       - Hit: splice entry to the front (O(1))
+       - Full: drop the entry at the back (least recently used)
+       - CREATE TABLE clears the cache (schema changed)
+*/
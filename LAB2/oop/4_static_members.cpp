@@ -5,67 +5,226 @@
     - Static Variable: Shared by all objects of a class (only one copy)
     - Static Function: Can access only static members, called without object
     - Use Case: Counting objects, global class-level data, utility functions
+    - Threads: a plain "static int count; count++;" is a data race, and one
+      atomic counter makes every thread fight over the same cache line
+      -> the totals are SHARDED: 64 slots on separate cache lines, each
+         thread updates its own slot, reads add the slots up
+    - Money: balances are 64-bit integer cents, not double -> totals are exact
 */
 
 #include <iostream>
 #include <string>
+#include <climits>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 using namespace std;
 
+// ===== MONEY (64-bit fixed point: 1 unit = 1 cent) =====
+// Exact, no double drift, and overflow-checked: arithmetic goes through
+// checkedAdd / checkedSub / checkedScale, which return false instead of wrapping
+// (full version: assignment/banking/10_fixed_point_money.cpp)
+class Money {
+private:
+    long long cents;
+
+public:
+    static const long long MAX_CENTS = LLONG_MAX;
+    static const long long MIN_CENTS = LLONG_MIN;
+
+    Money() : cents(0) {}
+
+    // Static factory functions: build a Money without an object
+    static Money fromCents(long long c) {
+        Money m;
+        m.cents = c;
+        return m;
+    }
+
+    // Whole dollars; clamps to the largest amount instead of overflowing
+    static Money dollars(long long d) {
+        long long c;
+        if (__builtin_mul_overflow(d, 100, &c)) c = d < 0 ? MIN_CENTS : MAX_CENTS;
+        return fromCents(c);
+    }
+
+    long long toCents() const { return cents; }
+
+    // ----- Checked (false on overflow, 'out' untouched) -----
+    static bool checkedAdd(Money a, Money b, Money& out) {
+        long long c;
+        if (__builtin_add_overflow(a.cents, b.cents, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    static bool checkedSub(Money a, Money b, Money& out) {
+        long long c;
+        if (__builtin_sub_overflow(a.cents, b.cents, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    // a * numerator / denominator, rounded half away from zero (e.g. 4% = 4 / 100)
+    static bool checkedScale(Money a, long long numerator, long long denominator, Money& out) {
+        if (denominator == 0) return false;
+        __int128 p = (__int128)a.cents * numerator;
+        __int128 d = denominator;
+        bool negative = (p < 0) != (d < 0);
+        if (p < 0) p = -p;
+        if (d < 0) d = -d;
+        __int128 q = (p + d / 2) / d;                   // Magnitude, rounded half up
+        if (negative) q = -q;
+        if (q > MAX_CENTS || q < MIN_CENTS) return false;
+        out.cents = (long long)q;
+        return true;
+    }
+
+    bool operator==(Money o) const { return cents == o.cents; }
+    bool operator<(Money o) const { return cents < o.cents; }
+    bool operator<=(Money o) const { return cents <= o.cents; }
+    bool operator>(Money o) const { return cents > o.cents; }
+    bool operator>=(Money o) const { return cents >= o.cents; }
+};
+
+ostream& operator<<(ostream& out, Money m) {
+    long long c = m.toCents();
+    unsigned long long magnitude = c < 0 ? 0 - (unsigned long long)c : (unsigned long long)c;     // Safe for MIN_CENTS
+    out << (c < 0 ? "-" : "") << magnitude / 100 << "." << (magnitude % 100 < 10 ? "0" : "") << magnitude % 100;
+    return out;
+}
+
+// ===== SHARDED COUNTERS =====
+// Each thread is given one shard (round robin) and only ever updates that one.
+// Fast read : add up the shards without locking (may miss in-flight updates)
+// Exact read: lock every shard, then add up (a consistent snapshot)
+class ShardedStats {
+private:
+    static const int SHARDS = 64;
+
+    // alignas(64): each shard on its own cache line (no false sharing)
+    struct alignas(64) Shard {
+        mutex lock;                         // Uncontended unless 2 threads share a shard
+        atomic<long long> accounts;
+        atomic<long long> balanceCents;     // Cents: integers add exactly
+        Shard() : accounts(0), balanceCents(0) {}
+    };
+
+    Shard shards[SHARDS];
+    atomic<unsigned> nextShard;
+
+    Shard& myShard() {
+        thread_local int index = -1;
+        if (index < 0) index = (int)(nextShard.fetch_add(1) % SHARDS);
+        return shards[index];
+    }
+
+public:
+    ShardedStats() : nextShard(0) {}
+
+    void add(long long accountsDelta, long long centsDelta) {
+        Shard& s = myShard();
+        lock_guard<mutex> guard(s.lock);
+        s.accounts.fetch_add(accountsDelta, memory_order_relaxed);
+        s.balanceCents.fetch_add(centsDelta, memory_order_relaxed);
+    }
+
+    void readApproximate(long long& accounts, long long& cents) const {
+        accounts = 0;
+        cents = 0;
+        for (int i = 0; i < SHARDS; i++) {
+            accounts += shards[i].accounts.load(memory_order_relaxed);
+            cents += shards[i].balanceCents.load(memory_order_relaxed);
+        }
+    }
+
+    void readExact(long long& accounts, long long& cents) {
+        for (int i = 0; i < SHARDS; i++) shards[i].lock.lock();        // Always in index order
+        readApproximate(accounts, cents);
+        for (int i = SHARDS - 1; i >= 0; i--) shards[i].lock.unlock();
+    }
+};
+
 class BankAccount {
 private:
     // Instance variables: Each object has its own copy
     string accountHolder;
-    double balance;
+    Money balance;
     
     // Static variable: SHARED by all BankAccount objects (only one copy in memory)
-    static int totalAccounts;      // Count of all accounts created
-    static double totalBalance;    // Sum of all balances
+    // totalAccounts + totalBalance live in one sharded, thread-safe object
+    static ShardedStats totals;
 
     // Static constant: Class-level constant
-    static const double MINIMUM_BALANCE;
+    static const Money MINIMUM_BALANCE;
 
 public:
     // Constructor: Each time object created
-    BankAccount(string holder, double initialBalance) 
+    BankAccount(string holder, Money initialBalance) 
         : accountHolder(holder), balance(initialBalance) {
         
         // Modify static members (shared by all objects)
-        totalAccounts++;      // Increment total count
-        totalBalance += balance;
+        totals.add(1, balance.toCents());    // One more account, its balance
         
-        cout << "Account created for " << accountHolder 
-             << " with balance $" << balance << endl;
+        if (verbose) {
+            cout << "Account created for " << accountHolder 
+                 << " with balance $" << balance << endl;
+        }
+    }
+
+    // Copy constructor: a copy is one MORE account, so it registers too
+    // (otherwise its destructor would subtract an account never added)
+    BankAccount(const BankAccount& other)
+        : accountHolder(other.accountHolder), balance(other.balance) {
+        totals.add(1, balance.toCents());
+    }
+
+    // Copy assignment: same number of accounts, only the balance changes
+    BankAccount& operator=(const BankAccount& other) {
+        totals.add(0, other.balance.toCents() - balance.toCents());
+        accountHolder = other.accountHolder;
+        balance = other.balance;
+        return *this;
     }
 
     // Destructor: When object destroyed
     ~BankAccount() {
         // Update static members when account deleted
-        totalBalance -= balance;
-        totalAccounts--;
+        totals.add(-1, -balance.toCents());
     }
 
     // Instance function: Can access both instance and static members
-    void deposit(double amount) {
-        if (amount > 0) {
-            balance += amount;
-            totalBalance += amount;
-            cout << accountHolder << " deposited $" << amount << endl;
+    // Rejected (false) if the new balance would not fit in 64 bits
+    bool deposit(Money amount) {
+        Money updated;
+        if (!(amount > Money())) return false;
+        if (!Money::checkedAdd(balance, amount, updated)) {
+            if (verbose) cout << "Error: deposit of $" << amount << " would overflow the balance" << endl;
+            return false;
         }
+        balance = updated;
+        totals.add(0, amount.toCents());
+        if (verbose) cout << accountHolder << " deposited $" << amount << endl;
+        return true;
     }
 
     // Instance function: Can access both instance and static members
-    void withdraw(double amount) {
-        if (amount > 0 && (balance - amount >= MINIMUM_BALANCE)) {
-            balance -= amount;
-            totalBalance -= amount;
-            cout << accountHolder << " withdrew $" << amount << endl;
-        } else {
-            cout << "Withdrawal failed - insufficient funds or below minimum" << endl;
+    bool withdraw(Money amount) {
+        Money updated;
+        if (amount > Money() && Money::checkedSub(balance, amount, updated) && updated >= MINIMUM_BALANCE) {
+            balance = updated;
+            totals.add(0, -amount.toCents());
+            if (verbose) cout << accountHolder << " withdrew $" << amount << endl;
+            return true;
         }
+        if (verbose) cout << "Withdrawal failed - insufficient funds or below minimum" << endl;
+        return false;
     }
 
     // Getter: Returns instance variable
-    double getBalance() const {
+    Money getBalance() const {
         return balance;
     }
 
@@ -77,45 +236,60 @@ public:
     // Static function: Can access ONLY static members
     // Called using ClassName::functionName()
     // NO 'this' pointer available
-    static int getTotalAccounts() {
-        return totalAccounts;
+    // exact = false: fast, lock-free (may lag behind updates still running)
+    // exact = true : locks all shards for a consistent snapshot
+    static int getTotalAccounts(bool exact = false) {
+        long long accounts, cents;
+        if (exact) totals.readExact(accounts, cents);
+        else totals.readApproximate(accounts, cents);
+        return (int)accounts;
     }
 
     // Static function: Returns total balance of all accounts
-    static double getTotalBalance() {
-        return totalBalance;
+    static Money getTotalBalance(bool exact = false) {
+        long long accounts, cents;
+        if (exact) totals.readExact(accounts, cents);
+        else totals.readApproximate(accounts, cents);
+        return Money::fromCents(cents);
     }
 
     // Static function: Returns minimum balance requirement
-    static double getMinimumBalance() {
+    static Money getMinimumBalance() {
         return MINIMUM_BALANCE;
     }
 
     // Static function: Displays bank statistics
+    // Exact snapshot: count and balance read together, so the average is consistent
     static void displayBankStats() {
+        long long totalAccounts, totalCents;
+        totals.readExact(totalAccounts, totalCents);
+        Money totalBalance = Money::fromCents(totalCents);
         cout << "\n===== BANK STATISTICS =====" << endl;
         cout << "Total Accounts: " << totalAccounts << endl;
         cout << "Total Balance in Bank: $" << totalBalance << endl;
         if (totalAccounts > 0) {
-            cout << "Average Balance: $" << (totalBalance / totalAccounts) << endl;
+            cout << "Average Balance: $" << Money::fromCents((totalCents + totalAccounts / 2) / totalAccounts) << endl;   // Nearest cent
         }
     }
+
+    // Static variable: print a line per operation? (off for the threaded demo)
+    static bool verbose;
 };
 
 // Static variable definitions OUTSIDE the class (required!)
 // Initialize the static variables
-int BankAccount::totalAccounts = 0;
-double BankAccount::totalBalance = 0.0;
+ShardedStats BankAccount::totals;
+bool BankAccount::verbose = true;
 
 // Static constant definition
-const double BankAccount::MINIMUM_BALANCE = 100.0;
+const Money BankAccount::MINIMUM_BALANCE = Money::dollars(100);
 
 int main() {
     cout << "===== Creating Bank Accounts =====" << endl;
     
-    BankAccount acc1("Alice", 1000);
-    BankAccount acc2("Bob", 1500);
-    BankAccount acc3("Charlie", 2000);
+    BankAccount acc1("Alice", Money::dollars(1000));
+    BankAccount acc2("Bob", Money::dollars(1500));
+    BankAccount acc3("Charlie", Money::dollars(2000));
 
     cout << "\n===== Accessing Static Members via Static Functions =====" << endl;
     // Call static function WITHOUT creating object
@@ -123,10 +297,10 @@ int main() {
     cout << "Total Balance (static): $" << BankAccount::getTotalBalance() << endl;
 
     cout << "\n===== Performing Transactions =====" << endl;
-    acc1.deposit(500);      // Alice deposits $500
+    acc1.deposit(Money::dollars(500));      // Alice deposits $500
     BankAccount::displayBankStats();  // Show updated stats
 
-    acc2.withdraw(300);     // Bob withdraws $300
+    acc2.withdraw(Money::dollars(300));     // Bob withdraws $300
     BankAccount::displayBankStats();  // Show updated stats
 
     cout << "\n===== Instance Variables vs Static Variables =====" << endl;
@@ -137,11 +311,71 @@ int main() {
 
     cout << "\n===== Attempting Invalid Withdrawal =====" << endl;
     cout << "Minimum Balance Required: $" << BankAccount::getMinimumBalance() << endl;
-    acc1.withdraw(2000);  // Should fail - would go below minimum
+    acc1.withdraw(Money::dollars(2000));  // Should fail - would go below minimum
+
+    cout << "\n===== Attempting Overflowing Deposit =====" << endl;
+    {
+        BankAccount rich("Dana", Money::fromCents(Money::MAX_CENTS - 100));
+        bool accepted = rich.deposit(Money::dollars(5));           // Would pass the 64-bit limit
+        cout << "Overflowing deposit rejected: " << (!accepted ? "YES" : "NO")
+             << ", balance unchanged: " << (rich.getBalance() == Money::fromCents(Money::MAX_CENTS - 100) ? "YES" : "NO") << endl;
+    }
 
     cout << "\n===== Final Bank Statistics =====" << endl;
     BankAccount::displayBankStats();
 
+    cout << "\n===== Copying Accounts =====" << endl;
+    {
+        int before = BankAccount::getTotalAccounts(true);
+        BankAccount::verbose = false;
+        vector<BankAccount> grown;              // No reserve: growing copies every element
+        for (int i = 0; i < 100; i++) grown.push_back(BankAccount("copy", Money::dollars(10)));
+        BankAccount::verbose = true;
+        cout << "100 accounts in a growing vector -> total accounts: " << BankAccount::getTotalAccounts(true)
+             << " (expected " << before + 100 << ")" << endl;
+    }
+    cout << "After the vector is gone: " << BankAccount::getTotalAccounts(true) << " accounts" << endl;
+
+    cout << "\n===== Many Threads Creating Accounts =====" << endl;
+    {
+        const int THREADS = 64;
+        const int PER_THREAD = 2000;
+        BankAccount::verbose = false;
+        int before = BankAccount::getTotalAccounts(true);
+        atomic<int> ready(0);
+        atomic<bool> release(false);
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (int t = 0; t < THREADS; t++) {
+            workers.push_back(thread([&]() {
+                vector<BankAccount> mine;
+                mine.reserve(PER_THREAD);
+                for (int i = 0; i < PER_THREAD; i++) {
+                    mine.emplace_back("user", Money::dollars(200));   // Built in place (copies would register too)
+                    mine.back().deposit(Money::dollars(50));
+                }
+                ready++;
+                while (!release) this_thread::yield();  // Keep accounts open until main has read
+            }));                                        // All close at thread end
+        }
+        while (ready < THREADS) this_thread::yield();
+        cout << "While open -> fast read: " << BankAccount::getTotalAccounts()
+             << " accounts, exact read: " << BankAccount::getTotalAccounts(true) << " accounts, $"
+             << BankAccount::getTotalBalance(true) << endl;
+        release = true;
+        for (int t = 0; t < THREADS; t++) workers[t].join();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << THREADS << " threads x " << PER_THREAD << " accounts created, deposited into, closed in "
+             << ms << " ms" << endl;
+        cout << "Exact count afterwards: " << BankAccount::getTotalAccounts(true)
+             << (BankAccount::getTotalAccounts(true) == before ? " (back to " + to_string(before) + ", correct)" : " (WRONG)")
+             << endl;
+        cout << "Exact balance afterwards: $" << BankAccount::getTotalBalance(true) << endl;
+        BankAccount::verbose = true;
+    }
+
     cout << "\n===== Account Deletion (Accounts Going Out of Scope) =====" << endl;
     return 0;
     // As each account destroyed, totalAccounts and totalBalance updated
@@ -170,7 +404,7 @@ int main() {
        - Global configuration: Class-level settings
     
     4. Static Constant
-       - const double MINIMUM_BALANCE = 100.0;
+       - const Money MINIMUM_BALANCE = Money::dollars(100);
        - Compile-time constant shared by all objects
     
     5. Important Rules
@@ -184,4 +418,17 @@ int main() {
        - Factory methods (create objects)
        - Utility functions (don't need object state)
        - Counters and statistics
+
+    7. Static Data and Threads
+       - totalAccounts++ from many threads: lost updates (data race)
+       - One atomic: correct, but every update bounces one cache line
+       - Sharded counters: each thread adds into its own 64-byte slot
+       - getTotalAccounts(): fast, lock-free sum (approximate while busy)
+       - getTotalAccounts(true) / displayBankStats(): lock all shards ->
+         exact, consistent snapshot of count AND balance together
+       - Balance kept in integer cents (Money): sums never drift
+       - deposit()/withdraw() use Money::checkedAdd / checkedSub: an amount
+         that would overflow 64 bits is rejected, never wrapped
+       - Copies register like new accounts (copy constructor adds, destructor
+         subtracts), so vectors may grow and copy freely
 */
@@ -6,23 +6,154 @@
     - Data Hiding: Private members accessible only through public interface
     - Benefits: Control access, validate data, implement changes without breaking code
     - Access Levels: private (only class), protected (class+derived), public (everyone)
+    - Hidden internals can change freely: the history is stored as fixed-size
+      binary records in 64-record chunks, and turned into text only when displayed
+    - Money is 64-bit integer cents (not double): every balance is exact
 */
 
 #include <iostream>
 #include <string>
+#include <climits>
 #include <vector>
 #include <ctime>
+#include <unordered_map>
 using namespace std;
 
+// ===== MONEY (64-bit fixed point: 1 unit = 1 cent) =====
+// Exact, no double drift, and overflow-checked: arithmetic goes through
+// checkedAdd / checkedSub / checkedScale, which return false instead of wrapping
+// (full version: assignment/banking/10_fixed_point_money.cpp)
+class Money {
+private:
+    long long cents;
+
+public:
+    static const long long MAX_CENTS = LLONG_MAX;
+    static const long long MIN_CENTS = LLONG_MIN;
+
+    Money() : cents(0) {}
+
+    static Money fromCents(long long c) {
+        Money m;
+        m.cents = c;
+        return m;
+    }
+
+    // Whole dollars; clamps to the largest amount instead of overflowing
+    static Money dollars(long long d) {
+        long long c;
+        if (__builtin_mul_overflow(d, 100, &c)) c = d < 0 ? MIN_CENTS : MAX_CENTS;
+        return fromCents(c);
+    }
+
+    long long toCents() const { return cents; }
+
+    // ----- Checked (false on overflow, 'out' untouched) -----
+    static bool checkedAdd(Money a, Money b, Money& out) {
+        long long c;
+        if (__builtin_add_overflow(a.cents, b.cents, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    static bool checkedSub(Money a, Money b, Money& out) {
+        long long c;
+        if (__builtin_sub_overflow(a.cents, b.cents, &c)) return false;
+        out.cents = c;
+        return true;
+    }
+
+    // a * numerator / denominator, rounded half away from zero (e.g. 4% = 4 / 100)
+    static bool checkedScale(Money a, long long numerator, long long denominator, Money& out) {
+        if (denominator == 0) return false;
+        __int128 p = (__int128)a.cents * numerator;
+        __int128 d = denominator;
+        bool negative = (p < 0) != (d < 0);
+        if (p < 0) p = -p;
+        if (d < 0) d = -d;
+        __int128 q = (p + d / 2) / d;                   // Magnitude, rounded half up
+        if (negative) q = -q;
+        if (q > MAX_CENTS || q < MIN_CENTS) return false;
+        out.cents = (long long)q;
+        return true;
+    }
+
+    bool operator==(Money o) const { return cents == o.cents; }
+    bool operator<(Money o) const { return cents < o.cents; }
+    bool operator<=(Money o) const { return cents <= o.cents; }
+    bool operator>(Money o) const { return cents > o.cents; }
+    bool operator>=(Money o) const { return cents >= o.cents; }
+};
+
+ostream& operator<<(ostream& out, Money m) {
+    long long c = m.toCents();
+    unsigned long long magnitude = c < 0 ? 0 - (unsigned long long)c : (unsigned long long)c;     // Safe for MIN_CENTS
+    out << (c < 0 ? "-" : "") << magnitude / 100 << "." << (magnitude % 100 < 10 ? "0" : "") << magnitude % 100;
+    return out;
+}
+
+// ===== TRANSACTION RECORD =====
+// Fixed-size binary record: recording one costs no allocation and no formatting
+enum TransactionType : unsigned char {
+    TX_OPEN,
+    TX_DEPOSIT,
+    TX_WITHDRAWAL,
+    TX_TRANSFER_OUT,
+    TX_TRANSFER_IN,
+    TX_INTEREST
+};
+
+// Every account number is stored once in an intern table; a record keeps
+// only its 4-byte id, so account numbers can be any length
+const unsigned int NO_COUNTERPARTY = 0xFFFFFFFFu;
+
+class AccountNumbers {
+private:
+    vector<string> numbers;                 // id -> account number
+    unordered_map<string, unsigned int> ids; // account number -> id
+
+public:
+    static AccountNumbers& table() {
+        static AccountNumbers instance;
+        return instance;
+    }
+
+    // Same number always gets the same id
+    unsigned int intern(const string& number) {
+        unordered_map<string, unsigned int>::iterator it = ids.find(number);
+        if (it != ids.end()) return it->second;
+        unsigned int id = (unsigned int)numbers.size();
+        numbers.push_back(number);
+        ids[number] = id;
+        return id;
+    }
+
+    const string& lookup(unsigned int id) const {
+        return numbers[id];
+    }
+};
+
+struct Transaction {
+    time_t timestamp;
+    Money amount;
+    TransactionType type;
+    unsigned int counterparty;  // Intern id of the other account for transfers (NO_COUNTERPARTY otherwise)
+};
+
 // ===== ENCAPSULATED CLASS: BankAccount =====
 class BankAccount {
 private:
     // Private data: Hidden from outside world
     string accountNumber;
-    double balance;
+    unsigned int accountId;     // Intern id of accountNumber, used in transfer records
+    Money balance;
     string accountHolder;
     int pin;
-    vector<string> transactionHistory;
+
+    // Full history in chunks of HISTORY_CHUNK records: one allocation per
+    // 64 transactions, and existing records never move or get copied
+    static const size_t HISTORY_CHUNK = 64;
+    vector<vector<Transaction>> history;
 
     // Private helper function: Only used internally
     // Validates PIN without exposing it
@@ -31,17 +162,44 @@ private:
     }
 
     // Private helper: Records transactions internally
-    void recordTransaction(const string& transaction) {
-        transactionHistory.push_back(transaction);
+    // Hot path: fills the next slot of the current chunk
+    void recordTransaction(TransactionType type, Money amount, unsigned int counterparty = NO_COUNTERPARTY) {
+        if (history.empty() || history.back().size() == HISTORY_CHUNK) {
+            history.push_back(vector<Transaction>());
+            history.back().reserve(HISTORY_CHUNK);
+        }
+        Transaction t;
+        t.timestamp = time(nullptr);
+        t.amount = amount;
+        t.type = type;
+        t.counterparty = counterparty;
+        history.back().push_back(t);
+    }
+
+    // Text is built only here, when someone asks to see the history
+    static void printTransaction(const Transaction& t) {
+        char when[20];
+        strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", localtime(&t.timestamp));
+        cout << "  [" << when << "] ";
+        switch (t.type) {
+            case TX_OPEN:         cout << "Account opened with balance: $" << t.amount; break;
+            case TX_DEPOSIT:      cout << "Deposit: +$" << t.amount; break;
+            case TX_WITHDRAWAL:   cout << "Withdrawal: -$" << t.amount; break;
+            case TX_TRANSFER_OUT: cout << "Transfer to " << AccountNumbers::table().lookup(t.counterparty) << ": -$" << t.amount; break;
+            case TX_TRANSFER_IN:  cout << "Transfer from " << AccountNumbers::table().lookup(t.counterparty) << ": +$" << t.amount; break;
+            case TX_INTEREST:     cout << "Interest applied: +$" << t.amount; break;
+        }
+        cout << endl;
     }
 
 public:
     // Constructor: Sets initial state
-    BankAccount(string accNum, string holder, int initialPin, double initialBalance)
+    BankAccount(string accNum, string holder, int initialPin, Money initialBalance)
         : accountNumber(accNum), accountHolder(holder), pin(initialPin), 
           balance(initialBalance) {
+        accountId = AccountNumbers::table().intern(accountNumber);
         cout << "Account created for " << accountHolder << endl;
-        recordTransaction("Account opened with balance: $" + to_string(initialBalance));
+        recordTransaction(TX_OPEN, initialBalance);
     }
 
     // Destructor
@@ -64,7 +222,7 @@ public:
     }
 
     // Getter: Current balance (safe - read only)
-    double getBalance() const {
+    Money getBalance() const {
         return balance;
     }
 
@@ -106,17 +264,22 @@ public:
     // Pre-conditions:
     //   - Amount must be positive
     //   - PIN must be correct (security)
-    bool deposit(double amount, int enteredPin) {
+    bool deposit(Money amount, int enteredPin) {
         if (!validatePIN(enteredPin)) {
             cout << "Error: Invalid PIN!" << endl;
             return false;
         }
-        if (amount <= 0) {
+        if (amount <= Money()) {
             cout << "Error: Deposit amount must be positive!" << endl;
             return false;
         }
-        balance += amount;
-        recordTransaction("Deposit: +$" + to_string(amount));
+        Money updated;
+        if (!Money::checkedAdd(balance, amount, updated)) {
+            cout << "Error: Deposit would overflow the balance!" << endl;
+            return false;
+        }
+        balance = updated;
+        recordTransaction(TX_DEPOSIT, amount);
         cout << "Deposited: $" << amount << ". New balance: $" << balance << endl;
         return true;
     }
@@ -127,16 +290,16 @@ public:
     //   - Sufficient balance must exist
     //   - PIN must be correct
     //   - Amount must not exceed limit ($1000/day)
-    bool withdraw(double amount, int enteredPin) {
+    bool withdraw(Money amount, int enteredPin) {
         if (!validatePIN(enteredPin)) {
             cout << "Error: Invalid PIN!" << endl;
             return false;
         }
-        if (amount <= 0) {
+        if (amount <= Money()) {
             cout << "Error: Withdrawal amount must be positive!" << endl;
             return false;
         }
-        if (amount > 1000) {
+        if (amount > Money::dollars(1000)) {
             cout << "Error: Daily withdrawal limit is $1000!" << endl;
             return false;
         }
@@ -145,20 +308,25 @@ public:
             cout << "Available balance: $" << balance << endl;
             return false;
         }
-        balance -= amount;
-        recordTransaction("Withdrawal: -$" + to_string(amount));
+        Money updated;
+        if (!Money::checkedSub(balance, amount, updated)) {
+            cout << "Error: Withdrawal would overflow the balance!" << endl;
+            return false;
+        }
+        balance = updated;
+        recordTransaction(TX_WITHDRAWAL, amount);
         cout << "Withdrawn: $" << amount << ". New balance: $" << balance << endl;
         return true;
     }
 
     // Transfer: Send money to another account
     // Complex operation using multiple validations
-    bool transfer(BankAccount& recipient, double amount, int enteredPin) {
+    bool transfer(BankAccount& recipient, Money amount, int enteredPin) {
         if (!validatePIN(enteredPin)) {
             cout << "Error: Invalid PIN!" << endl;
             return false;
         }
-        if (amount <= 0) {
+        if (amount <= Money()) {
             cout << "Error: Transfer amount must be positive!" << endl;
             return false;
         }
@@ -166,33 +334,49 @@ public:
             cout << "Error: Insufficient funds for transfer!" << endl;
             return false;
         }
+        // Both new balances are computed first: nothing changes unless both fit
+        Money senderAfter, recipientAfter;
+        if (!Money::checkedSub(balance, amount, senderAfter) ||
+            !Money::checkedAdd(recipient.balance, amount, recipientAfter)) {
+            cout << "Error: Transfer would overflow a balance!" << endl;
+            return false;
+        }
         
         // Perform transfer
-        balance -= amount;
-        recipient.balance += amount;
+        balance = senderAfter;
+        recipient.balance = recipientAfter;
         
-        recordTransaction("Transfer to " + recipient.accountNumber + ": -$" + to_string(amount));
-        recipient.recordTransaction("Transfer from " + accountNumber + ": +$" + to_string(amount));
+        recordTransaction(TX_TRANSFER_OUT, amount, recipient.accountId);
+        recipient.recordTransaction(TX_TRANSFER_IN, amount, accountId);
         
         cout << "Transferred $" << amount << " to " << recipient.accountNumber << endl;
         return true;
     }
 
     // Check interest earned (calculation based on balance)
-    double getInterestEarned() const {
-        return balance * 0.04;  // 4% annual interest
+    // 4% annual interest, exact to the cent (4/100 of an int64 always fits)
+    Money getInterestEarned() const {
+        Money interest;
+        Money::checkedScale(balance, 4, 100, interest);
+        return interest;
     }
 
     // Apply interest to account
-    void applyInterest(int enteredPin) {
+    bool applyInterest(int enteredPin) {
         if (!validatePIN(enteredPin)) {
             cout << "Error: Invalid PIN!" << endl;
-            return;
+            return false;
+        }
+        Money interest = getInterestEarned();
+        Money updated;
+        if (!Money::checkedAdd(balance, interest, updated)) {
+            cout << "Error: Interest would overflow the balance!" << endl;
+            return false;
         }
-        double interest = getInterestEarned();
-        balance += interest;
-        recordTransaction("Interest applied: +$" + to_string(interest));
+        balance = updated;
+        recordTransaction(TX_INTEREST, interest);
         cout << "Interest applied: $" << interest << endl;
+        return true;
     }
 
     // Display transaction history (limited - only holder can see)
@@ -202,16 +386,21 @@ public:
             return;
         }
         cout << "\n--- Transaction History for " << accountNumber << " ---" << endl;
-        for (const auto& transaction : transactionHistory) {
-            cout << "  " << transaction << endl;
+        // Oldest record first, chunk by chunk
+        for (size_t c = 0; c < history.size(); c++) {
+            for (size_t i = 0; i < history[c].size(); i++) printTransaction(history[c][i]);
         }
     }
+
+    size_t getTransactionCount() const {
+        return history.empty() ? 0 : (history.size() - 1) * HISTORY_CHUNK + history.back().size();
+    }
 };
 
 int main() {
     cout << "===== CREATING ENCAPSULATED ACCOUNTS =====" << endl;
-    BankAccount account1("ACC001", "Alice", 1234, 1000);
-    BankAccount account2("ACC002", "Bob", 5678, 500);
+    BankAccount account1("ACC001", "Alice", 1234, Money::dollars(1000));
+    BankAccount account2("ACC002", "Bob", 5678, Money::dollars(500));
 
     cout << "\n===== ACCESSING PRIVATE DATA VIA GETTERS =====" << endl;
     cout << "Account: " << account1.getAccountNumber() << endl;
@@ -219,13 +408,13 @@ int main() {
     cout << "Balance: $" << account1.getBalance() << endl;
 
     cout << "\n===== ATTEMPTING INVALID OPERATIONS (Encapsulation Prevents) =====" << endl;
-    account1.deposit(-100, 1234);      // Negative amount rejected
-    account1.withdraw(2000, 1234);     // Exceeds limit rejected
-    account1.withdraw(500, 9999);      // Wrong PIN rejected
+    account1.deposit(Money::dollars(-100), 1234);      // Negative amount rejected
+    account1.withdraw(Money::dollars(2000), 1234);     // Exceeds limit rejected
+    account1.withdraw(Money::dollars(500), 9999);      // Wrong PIN rejected
 
     cout << "\n===== VALID OPERATIONS =====" << endl;
-    account1.deposit(500, 1234);       // Correct PIN, valid amount
-    account1.withdraw(250, 1234);      // Correct PIN, valid amount
+    account1.deposit(Money::dollars(500), 1234);       // Correct PIN, valid amount
+    account1.withdraw(Money::dollars(250), 1234);      // Correct PIN, valid amount
 
     cout << "\n===== CALCULATING INTEREST =====" << endl;
     cout << "Interest earned on $" << account1.getBalance() 
@@ -233,18 +422,45 @@ int main() {
     account1.applyInterest(1234);
 
     cout << "\n===== TRANSFER BETWEEN ACCOUNTS =====" << endl;
-    account1.transfer(account2, 300, 1234);  // Correct PIN
+    account1.transfer(account2, Money::dollars(300), 1234);  // Correct PIN
     cout << "Account 1 balance: $" << account1.getBalance() << endl;
     cout << "Account 2 balance: $" << account2.getBalance() << endl;
 
     cout << "\n===== CHANGING PIN =====" << endl;
     account1.changePIN(9999, 4321);    // Wrong old PIN
     account1.changePIN(1234, 4321);    // Correct old PIN
-    account1.withdraw(100, 4321);      // Using new PIN
+    account1.withdraw(Money::dollars(100), 4321);      // Using new PIN
 
     cout << "\n===== VIEWING TRANSACTION HISTORY =====" << endl;
     account1.displayHistory(4321);     // Correct PIN
 
+    cout << "\n===== LONG HISTORY (nothing is dropped) =====" << endl;
+    for (int i = 1; i <= 70; i++) {
+        account2.deposit(Money::dollars(i), 5678);
+    }
+    cout << "Account 2 has " << account2.getTransactionCount() << " transactions recorded (1 open + 1 transfer + 70 deposits)" << endl;
+
+    cout << "\n===== LONG ACCOUNT NUMBER (stored once, records keep its id) =====" << endl;
+    BankAccount account3("ACC-2024-000000003", "Carol", 1111, Money::dollars(50));
+    bool sent = account1.transfer(account3, Money::dollars(10), 4321);
+    cout << "Transfer to long account number succeeded: " << (sent ? "YES" : "NO") << endl;
+    account3.displayHistory(1111);
+
+    cout << "\n===== AMOUNTS THAT WOULD OVERFLOW 64 BITS =====" << endl;
+    {
+        Money nearMax = Money::fromCents(Money::MAX_CENTS - 100);
+        BankAccount vault("ACC-VAULT", "Vault", 2222, nearMax);
+        bool deposited = vault.deposit(Money::dollars(5), 2222);
+        bool interest = vault.applyInterest(2222);
+        Money aliceBefore = account1.getBalance();
+        bool sent = account1.transfer(vault, Money::dollars(5), 4321);
+        cout << "Deposit rejected: " << (!deposited ? "YES" : "NO")
+             << ", interest rejected: " << (!interest ? "YES" : "NO")
+             << ", transfer rejected: " << (!sent ? "YES" : "NO") << endl;
+        cout << "Balances unchanged: "
+             << (vault.getBalance() == nearMax && account1.getBalance() == aliceBefore ? "YES" : "NO") << endl;
+    }
+
     cout << "\n===== ATTEMPTING UNAUTHORIZED ACCESS =====" << endl;
     account1.displayHistory(9999);     // Wrong PIN
 
@@ -282,6 +498,16 @@ int main() {
        - validatePIN(): Used internally only
        - recordTransaction(): Maintains history
        - Hidden complexity from users
+
+    5b. Binary History, Lazy Text
+       - recordTransaction() writes a fixed-size Transaction
+         (type, amount, counterparty, timestamp) into 64-record chunks
+       - No string building, no to_string(), one allocation per 64 operations
+       - displayHistory() formats the text only when it is actually shown
+       - Every transaction is kept; callers never see the change
+       - Counterparty is a 4-byte id into the AccountNumbers intern table:
+         each account number is stored once, at any length, and the
+         record stays 24 bytes
     
     6. Benefits of Encapsulation
        - Validation: No invalid state possible
@@ -294,11 +520,18 @@ int main() {
        - Class maintains consistent state
        - balance >= 0 always
        - pin always 4 digits
-       - transactions always recorded
+       - transactions always recorded (full history, oldest first)
     
     8. Information Hiding Levels
        - private: Best for internal state
        - protected: For derived classes
        - public: For external users
        - Each level has purpose
+
+    9. Money Instead of double
+       - balance and amounts are Money: 64-bit integer cents
+       - 4% interest rounds to the nearest cent once, then adds exactly
+       - Every change goes through checkedAdd / checkedSub: an operation that
+         would overflow 64 bits is rejected and no balance changes
+       - Callers only changed 1000 -> Money::dollars(1000): the class hid the rest
 */
@@ -0,0 +1,419 @@
+/*
+    8) DATA-ORIENTED PAYROLL (Same Results as the Virtual Path, Batch Speed)
+
+    Explanation:
+    - 5_abstract_classes.cpp: vector<Employee*>, and for EACH employee
+          virtual calculateSalary() -> Developer compares language STRINGS
+          ("C++"? "Python"? "Java"?) -> several cout lines
+      -> fine for 3 employees, slow for hundreds of thousands
+    - Payroll engine: the same rules, data stored per type as Structure of Arrays
+          managers  : id[], salary[], teamSize[]
+          developers: id[], salary[], projects[], languageId[]
+          designers : id[], salary[]
+    - Language table is INTERNED: each distinct string is stored once and
+      given a small id; the bonus per language sits in an array indexed by id
+      -> "C++" == "C++" string compare becomes bonusByLanguage[languageId[i]]
+    - Each pass is one simple loop per type: no virtual calls, no strings,
+      no I/O -> the compiler vectorizes it; threads split each loop by range
+    - Same operations in the same order as the virtual code, so the salaries
+      are bit-for-bit identical (checked at the end)
+
+    Compile with vectorization enabled (no -mfma: keep a + b * c as two
+    roundings, exactly like the virtual path):
+        g++ -O3 -mavx2 -pthread 8_data_oriented_payroll.cpp
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// =====================================================================
+// VIRTUAL PATH (rules copied from 5_abstract_classes.cpp)
+// =====================================================================
+class Employee {
+protected:
+    string name;
+    int employeeID;
+    double salary;
+
+public:
+    Employee(string n, int id, double s) : name(n), employeeID(id), salary(s) {}
+    virtual ~Employee() {}
+    virtual void calculateSalary() = 0;
+
+    virtual void giveBonus(double amount) {
+        salary += amount;
+        cout << name << " received bonus: $" << amount << endl;
+    }
+
+    double getSalary() const { return salary; }
+    int getID() const { return employeeID; }
+};
+
+class Manager : public Employee {
+private:
+    int teamSize;
+
+public:
+    Manager(string n, int id, double s, int team) : Employee(n, id, s), teamSize(team) {}
+
+    void calculateSalary() override {
+        cout << "Manager " << name << " salary calculation:" << endl;
+        double bonus = 5000 + (teamSize * 500);  // $500 per team member
+        salary += bonus;
+        cout << "  Base + Team Bonus: " << bonus << endl;
+        cout << "  Total Salary: $" << salary << endl;
+    }
+};
+
+class Developer : public Employee {
+private:
+    string programmingLanguage;
+    int projectsCompleted;
+
+public:
+    Developer(string n, int id, double s, string lang, int projects)
+        : Employee(n, id, s), programmingLanguage(lang), projectsCompleted(projects) {}
+
+    void calculateSalary() override {
+        cout << "Developer " << name << " salary calculation:" << endl;
+        double projectBonus = projectsCompleted * 1000;  // $1000 per project
+        double languageBonus = 0;
+
+        if (programmingLanguage == "C++") languageBonus = 3000;
+        else if (programmingLanguage == "Python") languageBonus = 2500;
+        else if (programmingLanguage == "Java") languageBonus = 2000;
+
+        salary += projectBonus + languageBonus;
+        cout << "  Project Bonus: $" << projectBonus << endl;
+        cout << "  Language Bonus: $" << languageBonus << endl;
+        cout << "  Total Salary: $" << salary << endl;
+    }
+};
+
+class Designer : public Employee {
+private:
+    string designTools;
+
+public:
+    Designer(string n, int id, double s, string tools) : Employee(n, id, s), designTools(tools) {}
+
+    void calculateSalary() override {
+        cout << "Designer " << name << " salary calculation:" << endl;
+        double creativeBonus = 3500;  // Fixed creative bonus
+        salary += creativeBonus;
+        cout << "  Creative Bonus: $" << creativeBonus << endl;
+        cout << "  Total Salary: $" << salary << endl;
+    }
+
+    void giveBonus(double amount) override {
+        cout << "DESIGN BONUS: Giving " << amount * 1.2 << " (20% extra for designers)" << endl;
+        salary += (amount * 1.2);
+    }
+};
+
+// =====================================================================
+// DATA-ORIENTED PATH
+// =====================================================================
+
+// ----- Interned language table -----
+class LanguageTable {
+private:
+    vector<string> names;               // id -> text (stored once)
+    vector<double> bonus;               // id -> language bonus
+
+public:
+    LanguageTable() {
+        // Same bonuses as Developer::calculateSalary; id 0 = "no bonus"
+        intern("");
+        setBonus(intern("C++"), 3000);
+        setBonus(intern("Python"), 2500);
+        setBonus(intern("Java"), 2000);
+    }
+
+    // Few distinct languages -> a linear search at load time is enough
+    uint8_t intern(const string& language) {
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i] == language) return (uint8_t)i;
+        }
+        if (names.size() == 256) {
+            cout << "Error: too many languages, \"" << language << "\" gets no bonus" << endl;
+            return 0;
+        }
+        names.push_back(language);
+        bonus.push_back(0);
+        return (uint8_t)(names.size() - 1);
+    }
+
+    void setBonus(uint8_t id, double amount) { bonus[id] = amount; }
+    const double* bonusTable() const { return bonus.data(); }
+    const string& name(uint8_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+};
+
+// ----- Per-type SoA tables -----
+struct ManagerTable {
+    vector<int> ids;
+    vector<double> salary;
+    vector<int> teamSize;
+};
+
+struct DeveloperTable {
+    vector<int> ids;
+    vector<double> salary;
+    vector<int> projects;
+    vector<uint8_t> languageId;
+};
+
+struct DesignerTable {
+    vector<int> ids;
+    vector<double> salary;
+};
+
+// Where each employee went: type + row (keeps the input order recoverable)
+struct EmployeeRef {
+    uint8_t type;                       // 0 manager, 1 developer, 2 designer
+    uint32_t row;
+};
+
+class PayrollEngine {
+private:
+    ManagerTable managers;
+    DeveloperTable developers;
+    DesignerTable designers;
+    LanguageTable languages;
+    vector<EmployeeRef> order;
+
+    // Run body(first, last) over [0, n) split across threads
+    template <typename Body>
+    static void parallelFor(size_t n, unsigned threads, Body body) {
+        if (threads <= 1 || n < 4096) {
+            body(0, n);
+            return;
+        }
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t first = n * t / threads, last = n * (t + 1) / threads;
+            workers.push_back(thread(body, first, last));
+        }
+        for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    }
+
+    // __restrict: the four arrays never overlap, so the compiler may gather
+    // bonus[lang[i]] for several developers at once
+    static void developerPass(double* __restrict salary, const int* __restrict projects,
+                              const uint8_t* __restrict lang, const double* __restrict bonus,
+                              size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) salary[i] += (double)(projects[i] * 1000) + bonus[lang[i]];
+    }
+
+public:
+    void addManager(int id, double s, int team) {
+        order.push_back({0, (uint32_t)managers.ids.size()});
+        managers.ids.push_back(id);
+        managers.salary.push_back(s);
+        managers.teamSize.push_back(team);
+    }
+
+    void addDeveloper(int id, double s, const string& lang, int projects) {
+        order.push_back({1, (uint32_t)developers.ids.size()});
+        developers.ids.push_back(id);
+        developers.salary.push_back(s);
+        developers.projects.push_back(projects);
+        developers.languageId.push_back(languages.intern(lang));
+    }
+
+    void addDesigner(int id, double s) {
+        order.push_back({2, (uint32_t)designers.ids.size()});
+        designers.ids.push_back(id);
+        designers.salary.push_back(s);
+    }
+
+    // ----- Pass 1: calculateSalary for everyone -----
+    // Each loop repeats the virtual body's arithmetic in the same order
+    void calculateSalaries(unsigned threads) {
+        double* ms = managers.salary.data();
+        const int* team = managers.teamSize.data();
+        parallelFor(managers.ids.size(), threads, [=](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) ms[i] += (double)(5000 + team[i] * 500);
+        });
+
+        double* ds = developers.salary.data();
+        const int* projects = developers.projects.data();
+        const uint8_t* lang = developers.languageId.data();
+        const double* bonus = languages.bonusTable();
+        parallelFor(developers.ids.size(), threads, [=](size_t first, size_t last) {
+            developerPass(ds, projects, lang, bonus, first, last);
+        });
+
+        double* gs = designers.salary.data();
+        parallelFor(designers.ids.size(), threads, [=](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) gs[i] += 3500.0;
+        });
+    }
+
+    // ----- Pass 2: giveBonus(amount) for everyone -----
+    void giveBonusAll(double amount, unsigned threads) {
+        double* ms = managers.salary.data();
+        parallelFor(managers.ids.size(), threads, [=](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) ms[i] += amount;
+        });
+        double* ds = developers.salary.data();
+        parallelFor(developers.ids.size(), threads, [=](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) ds[i] += amount;
+        });
+        const double designerBonus = amount * 1.2;          // Designer override: 20% extra
+        double* gs = designers.salary.data();
+        parallelFor(designers.ids.size(), threads, [=](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) gs[i] += designerBonus;
+        });
+    }
+
+    // Salary of the k-th employee added (input order)
+    double salaryOf(size_t k) const {
+        const EmployeeRef& r = order[k];
+        if (r.type == 0) return managers.salary[r.row];
+        if (r.type == 1) return developers.salary[r.row];
+        return designers.salary[r.row];
+    }
+
+    size_t size() const { return order.size(); }
+
+    void displayCounts() const {
+        cout << managers.ids.size() << " managers, " << developers.ids.size() << " developers, "
+             << designers.ids.size() << " designers, " << languages.size() - 1 << " distinct languages" << endl;
+    }
+};
+
+// Swallows output: the virtual path still formats every line, nothing reaches the terminal
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    cout << "===== SAME THREE EMPLOYEES AS 5_abstract_classes.cpp =====" << endl;
+    {
+        PayrollEngine engine;
+        engine.addManager(101, 50000, 5);
+        engine.addDeveloper(102, 45000, "C++", 8);
+        engine.addDesigner(103, 40000);
+        engine.calculateSalaries(1);
+        engine.giveBonusAll(1000, 1);
+        const char* names[] = {"Alice Johnson", "Bob Smith", "Carol White"};
+        for (size_t k = 0; k < engine.size(); k++) cout << names[k] << ": $" << engine.salaryOf(k) << endl;
+    }
+
+    const int N = 300000;
+    cout << "\n===== PAYROLL FOR " << N << " EMPLOYEES =====" << endl;
+    const char* langs[] = {"C++", "Python", "Java", "Go", "Rust", "JavaScript"};
+    vector<Employee*> staff;
+    staff.reserve(N);
+    PayrollEngine engine;
+    unsigned seed = 42;
+    for (int i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int kind = (seed >> 16) % 10;                       // 2 managers : 6 developers : 2 designers
+        double base = 30000 + (seed >> 8) % 40000 + ((seed >> 4) % 100) / 100.0;   // Cents in the base
+        int id = 1000 + i;
+        string name = "emp" + to_string(i);
+        if (kind < 2) {
+            int team = 1 + (seed >> 20) % 20;
+            staff.push_back(new Manager(name, id, base, team));
+            engine.addManager(id, base, team);
+        } else if (kind < 8) {
+            const char* lang = langs[(seed >> 12) % 6];
+            int projects = (seed >> 24) % 15;
+            staff.push_back(new Developer(name, id, base, lang, projects));
+            engine.addDeveloper(id, base, lang, projects);
+        } else {
+            staff.push_back(new Designer(name, id, base, "Figma"));
+            engine.addDesigner(id, base);
+        }
+    }
+    engine.displayCounts();
+
+    // Virtual path, output formatted into a null buffer
+    NullBuffer nothing;
+    streambuf* console = cout.rdbuf(&nothing);
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < staff.size(); i++) staff[i]->calculateSalary();
+    for (size_t i = 0; i < staff.size(); i++) staff[i]->giveBonus(1000);
+    double virtualMs = millisecondsSince(start);
+    cout.rdbuf(console);
+
+    start = chrono::steady_clock::now();
+    engine.calculateSalaries(1);
+    engine.giveBonusAll(1000, 1);
+    double engineMs = millisecondsSince(start);
+
+    unsigned threads = thread::hardware_concurrency();
+    if (threads < 2) threads = 2;
+    PayrollEngine parallel;
+    seed = 42;
+    for (int i = 0; i < N; i++) {                           // Same input again
+        seed = seed * 1103515245u + 12345u;
+        int kind = (seed >> 16) % 10;
+        double base = 30000 + (seed >> 8) % 40000 + ((seed >> 4) % 100) / 100.0;
+        if (kind < 2) parallel.addManager(1000 + i, base, 1 + (seed >> 20) % 20);
+        else if (kind < 8) parallel.addDeveloper(1000 + i, base, langs[(seed >> 12) % 6], (seed >> 24) % 15);
+        else parallel.addDesigner(1000 + i, base);
+    }
+    start = chrono::steady_clock::now();
+    parallel.calculateSalaries(threads);
+    parallel.giveBonusAll(1000, threads);
+    double parallelMs = millisecondsSince(start);
+
+    size_t mismatches = 0;
+    double total = 0;
+    for (size_t k = 0; k < staff.size(); k++) {
+        if (staff[k]->getSalary() != engine.salaryOf(k) || staff[k]->getSalary() != parallel.salaryOf(k)) mismatches++;
+        total += engine.salaryOf(k);
+    }
+
+    cout << "Virtual calls + cout      : " << virtualMs << " ms" << endl;
+    cout << "SoA passes, 1 thread      : " << engineMs << " ms (" << virtualMs / engineMs << "x faster)" << endl;
+    cout << "SoA passes, " << threads << " threads     : " << parallelMs << " ms" << endl;
+    cout << "Every salary identical to the virtual path: " << (mismatches == 0 ? "YES" : "NO") << endl;
+    cout.precision(15);
+    cout << "Total payroll: $" << total << endl;
+
+    for (size_t i = 0; i < staff.size(); i++) delete staff[i];
+    return 0;
+}
+
+/*
+    Key Concepts Explained:
+
+    1. Object-Oriented vs Data-Oriented
+       - OOP: one object holds all fields of one employee, behaviour via virtual calls
+       - DOD: one array holds one field of all employees of a type, behaviour via loops
+
+    2. Structure of Arrays per Type
+       - The type is known for the whole array: no dispatch per employee
+       - A pass touches only the columns it needs (salary + teamSize, ...)
+
+    3. String Interning
+       - Each distinct language stored once, employees keep a 1-byte id
+       - Bonus lookup: bonus[languageId[i]] instead of up to 3 string compares
+
+    4. No I/O in the Hot Path
+       - The virtual path formats ~5 lines per employee
+       - The engine computes only; reporting is a separate step
+
+    5. Vectorized, Parallel Passes
+       - Plain loops over double / int arrays -> SIMD
+       - Each pass is split into ranges: rows are independent, no locks
+
+    6. Identical Results
+       - Same formulas, same order of floating-point operations
+       - Checked employee by employee against the virtual path
+*/